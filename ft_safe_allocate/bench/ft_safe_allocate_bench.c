@@ -0,0 +1,317 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_bench.c                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 12:49:14 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 14:45:06 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_OPS 200000
+#define BENCH_LIVE 64
+#define BENCH_MAX_THREADS 32
+#define BENCH_BULK 50000
+#define BENCH_BATCH 256
+#define BENCH_PROBES 16
+
+typedef struct s_block
+{
+	unsigned char	*ptr;
+	size_t			size;
+	unsigned char	tag;
+}	t_block;
+
+static atomic_size_t	g_failures;
+
+static double	now_sec(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec + ts.tv_nsec / 1e9);
+}
+
+static void	*alloc_free_worker(void *arg)
+{
+	void	*live[BENCH_LIVE];
+	size_t	i;
+
+	(void)arg;
+	memset(live, 0, sizeof(live));
+	i = 0;
+	while (i < BENCH_OPS)
+	{
+		if (live[i % BENCH_LIVE])
+			ft_safe_allocate(NULL, FREE_ONE, live[i % BENCH_LIVE], NULL);
+		live[i % BENCH_LIVE] = ft_safe_allocate(
+				(size_t[2]){16 + (i % 8) * 16, 1}, ALLOCATE, NULL, NULL);
+		i++;
+	}
+	i = 0;
+	while (i < BENCH_LIVE)
+		ft_safe_allocate(NULL, FREE_ONE, live[i++], NULL);
+	return (NULL);
+}
+
+/*
+** Allocates BENCH_BATCH blocks, then frees them, one call per block or
+** one ALLOCATE_BATCH and one FREE_BATCH per round.
+*/
+static void	*batch_rounds(bool batch)
+{
+	void	*blocks[BENCH_BATCH];
+	size_t	round;
+	size_t	i;
+
+	round = 0;
+	while (round++ < BENCH_OPS / BENCH_BATCH)
+	{
+		if (batch)
+		{
+			ft_safe_allocate((size_t[2]){BENCH_BATCH, 32}, ALLOCATE_BATCH,
+				NULL, blocks);
+			ft_safe_allocate((size_t[1]){BENCH_BATCH}, FREE_BATCH, NULL,
+				blocks);
+			continue ;
+		}
+		i = 0;
+		while (i < BENCH_BATCH)
+			blocks[i++] = ft_safe_allocate((size_t[2]){1, 32}, ALLOCATE,
+					NULL, NULL);
+		while (i > 0)
+			ft_safe_allocate(NULL, FREE_ONE, blocks[--i], NULL);
+	}
+	return (NULL);
+}
+
+static void	*loop_worker(void *arg)
+{
+	(void)arg;
+	return (batch_rounds(false));
+}
+
+static void	*batch_worker(void *arg)
+{
+	(void)arg;
+	return (batch_rounds(true));
+}
+
+/*
+** Checks that the first n bytes of a block still hold its tag, so a
+** block handed to two threads or a realloc that lost data is reported.
+*/
+static void	verify(t_block *b, size_t n)
+{
+	size_t	i;
+
+	i = 0;
+	while (i < n && i < b->size)
+	{
+		if (b->ptr[i++] != b->tag)
+		{
+			atomic_fetch_add(&g_failures, 1);
+			return ;
+		}
+	}
+}
+
+static void	mixed_step(t_block *b, unsigned int r)
+{
+	size_t	size;
+	size_t	copy;
+
+	size = 8 + r % 512;
+	if (!b->ptr)
+	{
+		b->ptr = ft_safe_allocate((size_t[2]){size, 1}, ALLOCATE, NULL, NULL);
+		b->size = size;
+	}
+	else if (r % 3 == 0)
+	{
+		verify(b, b->size);
+		b->ptr = ft_safe_allocate(NULL, FREE_ONE, b->ptr, NULL);
+		return ;
+	}
+	else
+	{
+		copy = b->size;
+		if (size < copy)
+			copy = size;
+		b->ptr = ft_safe_allocate(
+				(size_t[2]){size, copy}, REALLOC, b->ptr, NULL);
+		verify(b, copy);
+		b->size = size;
+	}
+	b->tag = (unsigned char)(r >> 8);
+	memset(b->ptr, b->tag, b->size);
+}
+
+/*
+** Mixed ALLOCATE / REALLOC / FREE_ONE with content checks: a stress run
+** for the tracker as much as a throughput number.
+*/
+static void	*mixed_worker(void *arg)
+{
+	t_block			live[BENCH_LIVE];
+	unsigned int	seed;
+	size_t			i;
+
+	seed = (unsigned int)(uintptr_t)arg * 2654435761u + 1;
+	memset(live, 0, sizeof(live));
+	i = 0;
+	while (i < BENCH_OPS)
+	{
+		seed ^= seed << 13;
+		seed ^= seed >> 17;
+		seed ^= seed << 5;
+		mixed_step(&live[seed % BENCH_LIVE], seed >> 6);
+		i++;
+	}
+	i = 0;
+	while (i < BENCH_LIVE)
+	{
+		if (live[i].ptr)
+			ft_safe_allocate(NULL, FREE_ONE, live[i].ptr, NULL);
+		i++;
+	}
+	return (NULL);
+}
+
+static double	run_threads(void *(*worker)(void *), int count)
+{
+	pthread_t	threads[BENCH_MAX_THREADS];
+	double		start;
+	int			i;
+
+	start = now_sec();
+	i = 0;
+	while (i < count)
+	{
+		pthread_create(&threads[i], NULL, worker, (void *)(uintptr_t)i);
+		i++;
+	}
+	i = 0;
+	while (i < count)
+		pthread_join(threads[i++], NULL);
+	return (now_sec() - start);
+}
+
+/*
+** Resident set size of the process, from /proc/self/statm (0 elsewhere).
+*/
+static size_t	rss_kib(void)
+{
+	FILE	*statm;
+	size_t	pages;
+
+	pages = 0;
+	statm = fopen("/proc/self/statm", "r");
+	if (!statm)
+		return (0);
+	if (fscanf(statm, "%*s %zu", &pages) != 1)
+		pages = 0;
+	fclose(statm);
+	return (pages * (size_t)sysconf(_SC_PAGESIZE) / 1024);
+}
+
+/*
+** Probe length of every tracked entry: how many slots a lookup reads
+** before it reaches the entry.
+*/
+static void	probe_histogram(void)
+{
+	size_t	hist[BENCH_PROBES];
+	size_t	total;
+	size_t	count;
+	size_t	i;
+
+	tracker_probe_histogram_sa(tracker_sa(), hist, BENCH_PROBES);
+	total = 0;
+	count = 0;
+	printf("# probes:");
+	i = 0;
+	while (i < BENCH_PROBES)
+	{
+		if (hist[i] && i + 1 < BENCH_PROBES)
+			printf(" %zu:%zu", i + 1, hist[i]);
+		else if (hist[i])
+			printf(" %zu+:%zu", i + 1, hist[i]);
+		count += hist[i];
+		total += hist[i] * (i + 1);
+		i++;
+	}
+	if (count)
+		printf(", mean %.2f", (double)total / count);
+	printf("\n");
+}
+
+/*
+** Keeps BENCH_BULK blocks of 16 to 256 bytes live at once, so the memory
+** cost of each backend shows in the RSS growth.
+*/
+static void	bulk_run(void)
+{
+	static void	*blocks[BENCH_BULK];
+	size_t		rss;
+	double		start;
+	size_t		size;
+	size_t		i;
+
+	rss = rss_kib();
+	start = now_sec();
+	i = 0;
+	while (i < BENCH_BULK)
+	{
+		size = 16 + (i * 7919) % 241;
+		blocks[i] = ft_safe_allocate((size_t[2]){size, 1}, ALLOCATE, NULL,
+				NULL);
+		memset(blocks[i++], 0x5A, size);
+	}
+	printf("# bulk: %d live blocks, %.0f allocs/s, rss +%zu KiB\n",
+		BENCH_BULK, BENCH_BULK / (now_sec() - start), rss_kib() - rss);
+	probe_histogram();
+	i = 0;
+	while (i < BENCH_BULK)
+		ft_safe_allocate(NULL, FREE_ONE, blocks[i++], NULL);
+}
+
+int	main(void)
+{
+	double	pairs;
+	double	mixed;
+	double	loop;
+	int		threads;
+
+	printf("# SHARD_COUNT=%d LOCK_FREE_TRACKING=%d THREAD_MAGAZINES=%d "
+		"MEMORY_FENCING=%d INLINE_HEADER=%d SLAB_ALLOCATOR=%d "
+		"TABLE_MAX_LOAD=%d\n", SHARD_COUNT, LOCK_FREE_TRACKING,
+		THREAD_MAGAZINES, MEMORY_FENCING, INLINE_HEADER, SLAB_ALLOCATOR,
+		TABLE_MAX_LOAD);
+	bulk_run();
+	printf("%8s %14s %14s %14s %14s\n", "threads", "pairs/s",
+		"mixed ops/s", "loop pairs/s", "batch pairs/s");
+	threads = 1;
+	while (threads <= BENCH_MAX_THREADS)
+	{
+		pairs = threads * BENCH_OPS / run_threads(alloc_free_worker, threads);
+		mixed = threads * BENCH_OPS / run_threads(mixed_worker, threads);
+		loop = threads * BENCH_OPS / run_threads(loop_worker, threads);
+		printf("%8d %14.0f %14.0f %14.0f %14.0f\n", threads, pairs, mixed,
+			loop, threads * BENCH_OPS / run_threads(batch_worker, threads));
+		threads *= 2;
+	}
+	ft_safe_allocate(NULL, FREE_ALL, NULL, NULL);
+	if (atomic_load(&g_failures) || ft_safe_allocate(NULL, GET_USAGE, NULL,
+			NULL))
+		return (printf("FAILED: %zu corrupted blocks\n",
+				atomic_load(&g_failures)), 1);
+	return (0);
+}
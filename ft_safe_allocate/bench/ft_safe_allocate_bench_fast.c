@@ -0,0 +1,150 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_bench_fast.c                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 18:40:12 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 18:40:12 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+#include <stdio.h>
+#include <time.h>
+
+#define BENCH_OPS (1 << 20)
+#define BENCH_ROUNDS 5
+#define BENCH_LIVE 64
+
+static double	now_sec(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec + ts.tv_nsec / 1e9);
+}
+
+static void	*alloc_one(bool typed, size_t size)
+{
+	if (typed)
+		return (sa_alloc(1, size));
+	return (ft_safe_allocate((size_t[2]){1, size}, ALLOCATE, NULL, NULL));
+}
+
+/*
+** One loop per workload, through ft_safe_allocate() when typed is false
+** and through the sa_* entry points otherwise. Each op is one call.
+*/
+static void	pairs(bool typed)
+{
+	void	*live[BENCH_LIVE];
+	size_t	ops;
+	size_t	i;
+
+	ops = 0;
+	while (ops < BENCH_OPS)
+	{
+		i = 0;
+		while (i < BENCH_LIVE)
+		{
+			live[i] = alloc_one(typed, 16 + (i % 8) * 16);
+			i++;
+		}
+		i = 0;
+		while (i < BENCH_LIVE)
+		{
+			if (typed)
+				sa_free(live[i++]);
+			else
+				ft_safe_allocate(NULL, FREE_ONE, live[i++], NULL);
+		}
+		ops += 2 * BENCH_LIVE;
+	}
+}
+
+/*
+** Switches one block between two sizes of the same class, so every call
+** resizes in place and the dispatch is a visible share of its cost.
+*/
+static void	reallocs(bool typed)
+{
+	void	*ptr;
+	size_t	i;
+
+	ptr = sa_alloc(1, 32);
+	i = 0;
+	while (i < BENCH_OPS)
+	{
+		if (typed)
+			ptr = sa_realloc(ptr, 24, 24 + (i % 2) * 8);
+		else
+			ptr = ft_safe_allocate((size_t[2]){24 + (i % 2) * 8, 24},
+					REALLOC, ptr, NULL);
+		i++;
+	}
+	sa_free(ptr);
+}
+
+static void	usage(bool typed)
+{
+	volatile size_t	sink;
+	size_t			i;
+
+	i = 0;
+	while (i++ < BENCH_OPS)
+	{
+		if (typed)
+			sink = sa_usage();
+		else
+			sink = (size_t)ft_safe_allocate(NULL, GET_USAGE, NULL, NULL);
+	}
+	(void)sink;
+}
+
+/*
+** Best of BENCH_ROUNDS runs, in nanoseconds per call.
+*/
+static double	ns_per_call(void (*workload)(bool), bool typed)
+{
+	double	best;
+	double	start;
+	double	took;
+	int		round;
+
+	best = 0;
+	round = 0;
+	while (round++ < BENCH_ROUNDS)
+	{
+		start = now_sec();
+		workload(typed);
+		took = now_sec() - start;
+		if (round == 1 || took < best)
+			best = took;
+	}
+	return (best / BENCH_OPS * 1e9);
+}
+
+int	main(void)
+{
+	static const char	*names[3] = {"alloc/free", "realloc", "usage"};
+	static void			(*workloads[3])(bool) = {pairs, reallocs, usage};
+	double				dispatched;
+	double				typed;
+	int					i;
+
+	printf("%-12s %14s %14s %10s\n", "workload", "dispatch ns",
+		"typed ns", "saved ns");
+	i = 0;
+	while (i < 3)
+	{
+		dispatched = ns_per_call(workloads[i], false);
+		typed = ns_per_call(workloads[i], true);
+		printf("%-12s %14.2f %14.2f %10.2f\n", names[i], dispatched, typed,
+			dispatched - typed);
+		i++;
+	}
+	ft_safe_allocate(NULL, FREE_ALL, NULL, NULL);
+	return (0);
+}
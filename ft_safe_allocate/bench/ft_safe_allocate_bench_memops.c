@@ -0,0 +1,163 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_bench_memops.c                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 13:57:01 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 13:57:01 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_BYTES (256UL << 20)
+#define BENCH_MAX_SIZE (64UL << 20)
+#define BENCH_IMPLS 5
+
+typedef void	*(*t_set_fn)(void *, int, size_t);
+typedef void	*(*t_copy_fn)(void *, const void *, size_t);
+
+static const char	*g_names[BENCH_IMPLS] = {
+	"byte", "word", "sse2", "avx2", "libc"};
+
+static double	now_sec(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec + ts.tv_nsec / 1e9);
+}
+
+/*
+** The loops ft_memset_sa() and ft_memcpy_sa() used to run, as reference.
+** Built with -fno-tree-loop-distribute-patterns so they stay byte loops.
+*/
+static void	*byte_memset(void *b, int c, size_t len)
+{
+	unsigned char	*ptr;
+
+	ptr = b;
+	while (len-- > 0)
+		*(ptr++) = (unsigned char)c;
+	return (b);
+}
+
+static void	*byte_memcpy(void *dst, const void *src, size_t n)
+{
+	unsigned char		*d;
+	const unsigned char	*s;
+
+	d = dst;
+	s = src;
+	while (n-- > 0)
+		*(d++) = *(s++);
+	return (dst);
+}
+
+/*
+** Fills the implementation tables; SIMD versions the CPU lacks stay NULL.
+*/
+static void	pick_impls(t_set_fn *sets, t_copy_fn *copies)
+{
+	memset(sets, 0, BENCH_IMPLS * sizeof(*sets));
+	memset(copies, 0, BENCH_IMPLS * sizeof(*copies));
+	sets[0] = byte_memset;
+	copies[0] = byte_memcpy;
+	sets[1] = word_memset_sa;
+	copies[1] = word_memcpy_sa;
+	sets[4] = memset;
+	copies[4] = memcpy;
+#if SIMD_MEMOPS
+	if (__builtin_cpu_supports("sse2"))
+		sets[2] = sse2_memset_sa;
+	if (__builtin_cpu_supports("sse2"))
+		copies[2] = sse2_memcpy_sa;
+	if (__builtin_cpu_supports("avx2"))
+		sets[3] = avx2_memset_sa;
+	if (__builtin_cpu_supports("avx2"))
+		copies[3] = avx2_memcpy_sa;
+#endif
+}
+
+/*
+** GB/s of one implementation at one size: memset when set is given,
+** memcpy from src otherwise. Each run moves about BENCH_BYTES bytes.
+*/
+static double	gbps(t_set_fn set, t_copy_fn copy, unsigned char **bufs,
+	size_t size)
+{
+	double	start;
+	size_t	iters;
+	size_t	i;
+
+	iters = BENCH_BYTES / size;
+	if (iters == 0)
+		iters = 1;
+	start = now_sec();
+	i = 0;
+	while (i < iters)
+	{
+		if (set)
+			set(bufs[0], (int)i, size);
+		else
+			copy(bufs[0], bufs[1], size);
+		i++;
+	}
+	return ((double)iters * size / (now_sec() - start) / 1e9);
+}
+
+static void	run_table(const char *title, t_set_fn *sets, t_copy_fn *copies,
+	unsigned char **bufs)
+{
+	size_t	size;
+	int		i;
+
+	printf("%-8s %10s", title, "size");
+	i = 0;
+	while (i < BENCH_IMPLS)
+		printf(" %8s", g_names[i++]);
+	printf("\n");
+	size = 8;
+	while (size <= BENCH_MAX_SIZE)
+	{
+		printf("%-8s %10zu", title, size);
+		i = -1;
+		while (++i < BENCH_IMPLS)
+		{
+			if ((sets && sets[i]) || (!sets && copies[i]))
+				printf(" %8.2f", gbps(sets ? sets[i] : NULL,
+						copies[i], bufs, size));
+			else
+				printf(" %8s", "-");
+		}
+		printf("\n");
+		size *= 2;
+	}
+}
+
+int	main(void)
+{
+	t_set_fn		sets[BENCH_IMPLS];
+	t_copy_fn		copies[BENCH_IMPLS];
+	unsigned char	*bufs[2];
+
+	bufs[0] = malloc(BENCH_MAX_SIZE);
+	bufs[1] = malloc(BENCH_MAX_SIZE);
+	if (!bufs[0] || !bufs[1])
+		return (free(bufs[0]), free(bufs[1]), 1);
+	memset(bufs[0], 1, BENCH_MAX_SIZE);
+	memset(bufs[1], 2, BENCH_MAX_SIZE);
+	pick_impls(sets, copies);
+	printf("# GB/s, ft_memset_sa/ft_memcpy_sa dispatch to: %s\n",
+		memops_sa()->name);
+	run_table("memset", sets, copies, bufs);
+	run_table("memcpy", NULL, copies, bufs);
+	free(bufs[0]);
+	free(bufs[1]);
+	return (0);
+}
@@ -0,0 +1,147 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_bench_preload.c                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 18:02:44 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 18:02:44 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/*
+** Plain libc calls, no ft_safe_allocate include: run once as is and once
+** under LD_PRELOAD=ft_safe_allocate_preload.so to compare the two.
+*/
+#include <malloc.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_OPS 200000
+#define BENCH_LIVE 64
+#define BENCH_MAX_THREADS 32
+#define BENCH_REALLOC_STEPS 64
+
+static double	now_sec(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec + ts.tv_nsec / 1e9);
+}
+
+/*
+** mode 0: malloc/free, 1: calloc/free, 2: posix_memalign(64)/free. Each
+** block is touched once and its usable size read, so a broken interposer
+** shows up as a crash rather than a fast number.
+*/
+static void	*pair_worker(void *arg)
+{
+	void	*live[BENCH_LIVE];
+	size_t	size;
+	size_t	i;
+
+	memset(live, 0, sizeof(live));
+	i = 0;
+	while (i < BENCH_OPS)
+	{
+		free(live[i % BENCH_LIVE]);
+		size = 16 + (i % 8) * 16;
+		if ((uintptr_t)arg == 0)
+			live[i % BENCH_LIVE] = malloc(size);
+		else if ((uintptr_t)arg == 1)
+			live[i % BENCH_LIVE] = calloc(1, size);
+		else if (posix_memalign(&live[i % BENCH_LIVE], 64, size) != 0)
+			abort();
+		if (!live[i % BENCH_LIVE] || malloc_usable_size(live[i % BENCH_LIVE])
+			< size)
+			abort();
+		*(char *)live[i % BENCH_LIVE] = (char)i;
+		i++;
+	}
+	i = 0;
+	while (i < BENCH_LIVE)
+		free(live[i++]);
+	return (NULL);
+}
+
+/*
+** Grows a block from 16 bytes in BENCH_REALLOC_STEPS steps, checking that
+** realloc() kept the first byte; one op is one realloc() call.
+*/
+static void	*realloc_worker(void *arg)
+{
+	char	*ptr;
+	size_t	round;
+	size_t	step;
+
+	(void)arg;
+	round = 0;
+	while (round++ < BENCH_OPS / BENCH_REALLOC_STEPS)
+	{
+		ptr = malloc(16);
+		ptr[0] = (char)round;
+		step = 1;
+		while (step < BENCH_REALLOC_STEPS)
+		{
+			ptr = realloc(ptr, 16 + step++ * 48);
+			if (!ptr || ptr[0] != (char)round)
+				abort();
+		}
+		free(ptr);
+	}
+	return (NULL);
+}
+
+static double	run_threads(void *(*worker)(void *), void *arg, int count)
+{
+	pthread_t	threads[BENCH_MAX_THREADS];
+	double		start;
+	int			i;
+
+	start = now_sec();
+	i = 0;
+	while (i < count)
+		pthread_create(&threads[i++], NULL, worker, arg);
+	i = 0;
+	while (i < count)
+		pthread_join(threads[i++], NULL);
+	return (now_sec() - start);
+}
+
+int	main(int argc, char **argv)
+{
+	double	ops;
+	int		max;
+	int		threads;
+	int		mode;
+
+	max = 8;
+	if (argc > 2)
+		max = atoi(argv[2]);
+	if (max < 1 || max > BENCH_MAX_THREADS)
+		max = BENCH_MAX_THREADS;
+	printf("# allocator: %s\n", argc > 1 ? argv[1] : "unknown");
+	printf("%8s %14s %14s %14s %14s\n", "threads", "malloc pairs/s",
+		"calloc pairs/s", "memalign/s", "realloc/s");
+	threads = 1;
+	while (threads <= max)
+	{
+		printf("%8d", threads);
+		mode = 0;
+		while (mode < 3)
+		{
+			ops = (double)BENCH_OPS * threads;
+			printf(" %14.0f", ops / run_threads(pair_worker,
+					(void *)(uintptr_t)mode++, threads));
+		}
+		printf(" %14.0f\n", ops / run_threads(realloc_worker, NULL, threads));
+		threads *= 2;
+	}
+	return (0);
+}
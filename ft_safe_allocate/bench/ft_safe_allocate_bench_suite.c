@@ -0,0 +1,430 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_bench_suite.c                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 15:05:04 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 15:05:04 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/*
+** Tracker cost against plain malloc, written as CSV rows:
+** variant,workload,threads,ops,seconds,ops_per_sec
+**
+** Built once per variant: the library as is or with MEMORY_FENCING, the
+** linked-list version in "ft_safe_allocate _simple#" (BENCH_SIMPLE) and
+** plain malloc/free (BENCH_MALLOC). The simple version is not thread-safe,
+** so every call to it takes one global mutex, and it has no REALLOC, so
+** growth allocates, copies and frees. Workloads a variant cannot express
+** (GET_USAGE and freeing an unknown pointer with malloc) are skipped.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#if defined(BENCH_SIMPLE)
+# include "../../ft_safe_allocate _simple#/include/ft_safe_allocate.h"
+# define BENCH_VARIANT "simple"
+#elif defined(BENCH_MALLOC)
+# define BENCH_VARIANT "malloc"
+#else
+# include "../include/ft_safe_allocate.h"
+# if MEMORY_FENCING
+#  define BENCH_VARIANT "fenced"
+# else
+#  define BENCH_VARIANT "normal"
+# endif
+#endif
+
+#define BENCH_OPS 200000
+#define BENCH_LIVE 64
+#define BENCH_MAX_THREADS 64
+#define BENCH_FILL 50000
+#define BENCH_GROW_STEP 64
+#define BENCH_GROW_MAX 16384
+
+static void				*g_fill[BENCH_FILL];
+static int				g_threads;
+static atomic_size_t	g_ops;
+
+/* ************************************************************************** */
+/* 							Variant adapters                                  */
+/* ************************************************************************** */
+
+#if defined(BENCH_SIMPLE)
+
+static pthread_mutex_t	g_simple_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void	*b_alloc(size_t size)
+{
+	void	*ptr;
+
+	pthread_mutex_lock(&g_simple_lock);
+	ptr = ft_safe_allocate(size, 1, ALLOCATE, NULL);
+	pthread_mutex_unlock(&g_simple_lock);
+	return (ptr);
+}
+
+static void	b_free(void *ptr)
+{
+	pthread_mutex_lock(&g_simple_lock);
+	ft_safe_allocate(0, 0, FREE_ONE, ptr);
+	pthread_mutex_unlock(&g_simple_lock);
+}
+
+static void	*b_realloc(void *ptr, size_t old_size, size_t new_size)
+{
+	void	*grown;
+
+	grown = b_alloc(new_size);
+	memcpy(grown, ptr, old_size);
+	b_free(ptr);
+	return (grown);
+}
+
+static size_t	b_usage(void)
+{
+	size_t	usage;
+
+	pthread_mutex_lock(&g_simple_lock);
+	usage = (size_t)(uintptr_t)ft_safe_allocate(0, 0, GET_USAGE, NULL);
+	pthread_mutex_unlock(&g_simple_lock);
+	return (usage);
+}
+
+static void	b_free_all(void **blocks, size_t count)
+{
+	(void)blocks;
+	(void)count;
+	pthread_mutex_lock(&g_simple_lock);
+	ft_safe_allocate(0, 0, FREE_ALL, NULL);
+	pthread_mutex_unlock(&g_simple_lock);
+}
+
+# define B_HAS_USAGE true
+# define B_HAS_MISS true
+
+#elif defined(BENCH_MALLOC)
+
+static void	*b_alloc(size_t size)
+{
+	return (calloc(size, 1));
+}
+
+static void	b_free(void *ptr)
+{
+	free(ptr);
+}
+
+static void	*b_realloc(void *ptr, size_t old_size, size_t new_size)
+{
+	(void)old_size;
+	return (realloc(ptr, new_size));
+}
+
+static size_t	b_usage(void)
+{
+	return (0);
+}
+
+static void	b_free_all(void **blocks, size_t count)
+{
+	size_t	i;
+
+	i = 0;
+	while (i < count)
+		free(blocks[i++]);
+}
+
+# define B_HAS_USAGE false
+# define B_HAS_MISS false
+
+#else
+
+static void	*b_alloc(size_t size)
+{
+	return (ft_safe_allocate((size_t[2]){size, 1}, ALLOCATE, NULL, NULL));
+}
+
+static void	b_free(void *ptr)
+{
+	ft_safe_allocate(NULL, FREE_ONE, ptr, NULL);
+}
+
+static void	*b_realloc(void *ptr, size_t old_size, size_t new_size)
+{
+	return (ft_safe_allocate((size_t[2]){new_size, old_size}, REALLOC, ptr,
+		NULL));
+}
+
+static size_t	b_usage(void)
+{
+	return ((size_t)(uintptr_t)ft_safe_allocate(NULL, GET_USAGE, NULL,
+		NULL));
+}
+
+static void	b_free_all(void **blocks, size_t count)
+{
+	(void)blocks;
+	(void)count;
+	ft_safe_allocate(NULL, FREE_ALL, NULL, NULL);
+}
+
+# define B_HAS_USAGE true
+# define B_HAS_MISS true
+
+#endif
+
+/* ************************************************************************** */
+/* 							Workloads                                         */
+/* ************************************************************************** */
+
+static double	now_sec(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec + ts.tv_nsec / 1e9);
+}
+
+/*
+** ALLOCATE/FREE_ONE pairs over a window of BENCH_LIVE blocks per thread,
+** each block freed BENCH_LIVE allocations after it was made.
+*/
+static void	*alloc_free_worker(void *arg)
+{
+	void	*live[BENCH_LIVE];
+	size_t	i;
+
+	(void)arg;
+	memset(live, 0, sizeof(live));
+	i = 0;
+	while (i < BENCH_OPS)
+	{
+		if (live[i % BENCH_LIVE])
+			b_free(live[i % BENCH_LIVE]);
+		live[i % BENCH_LIVE] = b_alloc(16 + (i % 8) * 16);
+		i++;
+	}
+	i = 0;
+	while (i < BENCH_LIVE)
+		b_free(live[i++]);
+	atomic_fetch_add(&g_ops, BENCH_OPS);
+	return (NULL);
+}
+
+/*
+** A buffer grown BENCH_GROW_STEP bytes at a time up to BENCH_GROW_MAX,
+** like a string builder, then freed. Each REALLOC is one op.
+*/
+static void	*realloc_worker(void *arg)
+{
+	void	*buf;
+	size_t	size;
+	size_t	ops;
+
+	(void)arg;
+	ops = 0;
+	while (ops < BENCH_OPS / 4)
+	{
+		size = BENCH_GROW_STEP;
+		buf = b_alloc(size);
+		while (size < BENCH_GROW_MAX)
+		{
+			buf = b_realloc(buf, size, size + BENCH_GROW_STEP);
+			size += BENCH_GROW_STEP;
+			ops++;
+		}
+		b_free(buf);
+	}
+	atomic_fetch_add(&g_ops, ops);
+	return (NULL);
+}
+
+/*
+** GET_USAGE called over and over while every thread holds BENCH_LIVE
+** blocks, as a program watching its own footprint would.
+*/
+static void	*usage_worker(void *arg)
+{
+	void			*live[BENCH_LIVE];
+	volatile size_t	sink;
+	size_t			i;
+
+	(void)arg;
+	i = 0;
+	while (i < BENCH_LIVE)
+		live[i++] = b_alloc(64);
+	i = 0;
+	while (i < BENCH_OPS / 4)
+	{
+		sink = b_usage();
+		i++;
+	}
+	(void)sink;
+	i = 0;
+	while (i < BENCH_LIVE)
+		b_free(live[i++]);
+	atomic_fetch_add(&g_ops, BENCH_OPS / 4);
+	return (NULL);
+}
+
+/*
+** FREE_ONE on pointers the tracker never returned while BENCH_LIVE blocks
+** per thread are live: the lookup that has to fail, plus the warning.
+*/
+static void	*miss_worker(void *arg)
+{
+	void	*live[BENCH_LIVE];
+	size_t	i;
+
+	i = 0;
+	while (i < BENCH_LIVE)
+		live[i++] = b_alloc(64);
+	i = 0;
+	while (i < BENCH_OPS / 4)
+	{
+		b_free((void *)(0x10000 + ((uintptr_t)arg << 32) + i * 16));
+		i++;
+	}
+	i = 0;
+	while (i < BENCH_LIVE)
+		b_free(live[i++]);
+	atomic_fetch_add(&g_ops, BENCH_OPS / 4);
+	return (NULL);
+}
+
+static void	*fill_worker(void *arg)
+{
+	size_t	share;
+	size_t	i;
+
+	share = BENCH_FILL / g_threads;
+	i = (uintptr_t)arg * share;
+	while (i < ((uintptr_t)arg + 1) * share)
+	{
+		g_fill[i] = b_alloc(16 + (i % 16) * 16);
+		i++;
+	}
+	return (NULL);
+}
+
+/* ************************************************************************** */
+/* 							Driver                                            */
+/* ************************************************************************** */
+
+static double	run_threads(void *(*worker)(void *), int count)
+{
+	pthread_t	threads[BENCH_MAX_THREADS];
+	double		start;
+	int			i;
+
+	g_threads = count;
+	atomic_store(&g_ops, 0);
+	start = now_sec();
+	i = 0;
+	while (i < count)
+	{
+		pthread_create(&threads[i], NULL, worker, (void *)(uintptr_t)i);
+		i++;
+	}
+	i = 0;
+	while (i < count)
+		pthread_join(threads[i++], NULL);
+	return (now_sec() - start);
+}
+
+static void	report(FILE *csv, const char *workload, int threads,
+	double secs)
+{
+	size_t	ops;
+
+	ops = atomic_load(&g_ops);
+	fprintf(csv, "%s,%s,%d,%zu,%.6f,%.0f\n", BENCH_VARIANT, workload,
+		threads, ops, secs, ops / secs);
+}
+
+/*
+** Each thread fills its share of g_fill; the timed part is the FREE_ALL
+** (one free() per block for malloc) that follows.
+*/
+static double	free_all_run(int threads)
+{
+	size_t	count;
+	double	start;
+
+	run_threads(fill_worker, threads);
+	count = BENCH_FILL / threads * threads;
+	atomic_store(&g_ops, count);
+	start = now_sec();
+	b_free_all(g_fill, count);
+	return (now_sec() - start);
+}
+
+static void	run_all(FILE *csv, int threads)
+{
+	double	secs;
+
+	secs = run_threads(alloc_free_worker, threads);
+	report(csv, "alloc_free", threads, secs);
+	secs = run_threads(realloc_worker, threads);
+	report(csv, "realloc_grow", threads, secs);
+	if (B_HAS_USAGE)
+	{
+		secs = run_threads(usage_worker, threads);
+		report(csv, "usage_poll", threads, secs);
+	}
+	if (B_HAS_MISS)
+	{
+		secs = run_threads(miss_worker, threads);
+		report(csv, "free_miss", threads, secs);
+	}
+	secs = free_all_run(threads);
+	report(csv, "free_all", threads, secs);
+}
+
+/*
+** Usage: bench_suite_<variant> [file.csv] [max threads]
+** Rows are appended to the file (stdout by default), with the header line
+** only when the file is empty. Thread counts double from 1 to the maximum.
+*/
+int	main(int argc, char **argv)
+{
+	FILE	*csv;
+	int		max_threads;
+	int		threads;
+
+	csv = stdout;
+	if (argc > 1)
+		csv = fopen(argv[1], "a");
+	if (!csv)
+		return (perror(argv[1]), 1);
+	max_threads = 8;
+	if (argc > 2)
+		max_threads = atoi(argv[2]);
+	if (max_threads < 1 || max_threads > BENCH_MAX_THREADS)
+		max_threads = BENCH_MAX_THREADS;
+#if !defined(BENCH_SIMPLE) && !defined(BENCH_MALLOC)
+	ft_safe_allocate(NULL, DIAG_TARGET, "/dev/null", NULL);
+#endif
+	fseek(csv, 0, SEEK_END);
+	if (ftell(csv) <= 0)
+		fprintf(csv, "variant,workload,threads,ops,seconds,ops_per_sec\n");
+	threads = 1;
+	while (threads <= max_threads)
+	{
+		run_all(csv, threads);
+		fflush(csv);
+		threads *= 2;
+	}
+	return (fclose(csv), 0);
+}
@@ -6,25 +6,66 @@
 /*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/04/18 18:46:19 by mait-you          #+#    #+#             */
-/*   Updated: 2025/05/04 17:43:23 by mait-you         ###   ########.fr       */
+/*   Updated: 2026/10/17 18:29:54 by mait-you         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "../include/ft_safe_allocate.h"
 
-size_t	hash_ptr(const void *ptr)
+/*
+** The caller is passed down so that ft_safe_allocate() can share these
+** bodies and still tag blocks with its own caller rather than itself.
+*/
+static void	*alloc_at(
+	size_t count, size_t size, t_action action, void *caller)
 {
-	uintptr_t key;
-	
-	key = (uintptr_t)ptr;
-	key ^= (key >> 33);
-	key *= 0xff51afd7ed558ccd;
-	key ^= (key >> 33);
-	key *= 0xc4ceb9fe1a85ec53;
-	key ^= (key >> 33);
-	return ((size_t)(key % HASH_TABLE_SIZE));
+	void		*ptr;
+	uint64_t	start;
+
+	start = 0;
+	if (INSTRUMENT)
+		start = instr_clock_sa();
+	if (ALLOC_SITES || HEAP_PROFILE)
+		site_enter_sa(caller);
+	ptr = allocate_ptr((size_t[2]){count, size}, tracker_sa(), BLOCK_ALIGN,
+			action == ALLOCATE);
+	if (INSTRUMENT)
+		instr_action_sa(action, instr_clock_sa() - start);
+	return (ptr);
+}
+
+static void	*realloc_at(
+	void *ptr, size_t old_size, size_t new_size, void *caller)
+{
+	void		*new_ptr;
+	uint64_t	start;
+
+	start = 0;
+	if (INSTRUMENT)
+		start = instr_clock_sa();
+	if (ALLOC_SITES || HEAP_PROFILE)
+		site_enter_sa(caller);
+	new_ptr = realloc_ptr((size_t[2]){new_size, old_size}, tracker_sa(), ptr,
+			REALLOC);
+	if (INSTRUMENT)
+		instr_action_sa(REALLOC, instr_clock_sa() - start);
+	return (new_ptr);
+}
+
+void	*sa_alloc(size_t count, size_t size)
+{
+	return (alloc_at(count, size, ALLOCATE, __builtin_return_address(0)));
+}
+
+void	*sa_realloc(void *ptr, size_t old_size, size_t new_size)
+{
+	return (realloc_at(ptr, old_size, new_size, __builtin_return_address(0)));
 }
 
+/*
+** The four hot actions skip dispatch_sa(); FREE_ONE only when it frees a
+** single pointer, the other forms keep their warnings there.
+*/
 void	*ft_safe_allocate(
 	size_t *size,
 	t_action action,
@@ -32,29 +73,17 @@ void	*ft_safe_allocate(
 	void **double_ptr
 	)
 {
-	static t_allocation		ptr_array[HASH_TABLE_SIZE];
-	static pthread_mutex_t	init_mutex = PTHREAD_MUTEX_INITIALIZER;
-	void					*user_ptr;
-
-	pthread_mutex_lock(&init_mutex);
-	user_ptr = NULL;
-	if (action == ALLOCATE)
-		user_ptr = allocate_ptr(size, ptr_array);
-	else if (action == FREE_ALL)
-		user_ptr = free_all(ptr_array);
-	else if (action == FREE_ONE)
-		user_ptr = free_specific(ptr_array, ptr, double_ptr, size);
-	else if (action == GET_USAGE)
-		user_ptr = (void *)(uintptr_t)get_allocation_count(ptr_array);
-	else if (action == REALLOC)
-		user_ptr = realloc_ptr(size, ptr_array, ptr, REALLOC);
-	else if (MEMORY_FENCING && action == ADD_TO_TRACK)
-		user_ptr = realloc_ptr(size, ptr_array, ptr, ADD_TO_TRACK);
-	else if (!MEMORY_FENCING && action == ADD_TO_TRACK)
-	{
-		add_to_tracking(ptr_array, NULL, ptr, size);
-		user_ptr = ptr;
-	}
-	pthread_mutex_unlock(&init_mutex);
-	return (user_ptr);
+	if (action == ALLOCATE || action == ALLOCATE_UNINIT)
+		return (alloc_at(size[0], size[1], action,
+				__builtin_return_address(0)));
+	if (action == FREE_ONE && ptr && !double_ptr)
+		return (sa_free(ptr), NULL);
+	if (action == REALLOC)
+		return (realloc_at(ptr, size[1], size[0],
+				__builtin_return_address(0)));
+	if (action == GET_USAGE)
+		return ((void *)(uintptr_t)sa_usage());
+	if (ALLOC_SITES || HEAP_PROFILE)
+		site_enter_sa(__builtin_return_address(0));
+	return (dispatch_sa(size, action, ptr, double_ptr));
 }
@@ -6,7 +6,7 @@
 /*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/04/18 18:46:19 by mait-you          #+#    #+#             */
-/*   Updated: 2025/05/06 14:28:16 by mait-you         ###   ########.fr       */
+/*   Updated: 2026/10/17 19:43:36 by mait-you         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -32,117 +32,107 @@
 // }
 
 void    *realloc_ptr(
-	size_t *size, t_allocation *ptr_array, void *ptr, t_action action)
+	size_t *size, t_tracker *tracker, void *ptr, t_action action)
 {
 	void    *new_ptr;
+	size_t	copy;
 
 	if (!ptr)
-		return (allocate_ptr((size_t[2]){size[0], 1}, ptr_array));
+		return (allocate_ptr((size_t[2]){size[0], 1}, tracker, BLOCK_ALIGN,
+				true));
 	if (size[0] == 0)
-		return (free_specific(ptr_array, ptr, NULL, 0), NULL);
-	new_ptr = allocate_ptr((size_t[2]){size[0], 1}, ptr_array);
-	if (!new_ptr)
-		return (NULL);
-	if (ptr && size[1] > 0)
-		ft_memcpy_sa(new_ptr, ptr, size[1]);
-	if (action == REALLOC)
-		free_specific(ptr_array, ptr, NULL, 0);
-	else if (action == ADD_TO_TRACK)
+		return (free_specific(tracker, ptr, NULL, 0), NULL);
+	copy = size[1];
+	if (INLINE_HEADER && action == REALLOC && !header_sa(ptr))
+		return (free_specific(tracker, ptr, NULL, 0));
+	if (INLINE_HEADER && action == REALLOC && copy > header_sa(ptr)->size)
+		copy = header_sa(ptr)->size;
+	if (action == REALLOC
+		&& resize_in_place_sa(tracker, ptr, size, &new_ptr) == SUCCESS)
+		return (new_ptr);
+	new_ptr = allocate_ptr((size_t[2]){size[0], 1}, tracker, BLOCK_ALIGN,
+			true);
+	if (new_ptr && copy > 0)
+		ft_memcpy_sa(new_ptr, ptr, copy);
+	if (new_ptr && action == REALLOC)
+		free_specific(tracker, ptr, NULL, 0);
+	else if (new_ptr && action == ADD_TO_TRACK)
 		free(ptr);
 	return (new_ptr);
 }
 
-size_t	get_allocation_count(t_allocation *ptr_array)
-{
-	int		count;
-	size_t	bytes;
-	int	i;
-
-	count = 0;
-	i = 0;
-	bytes = 0;
-	while (i < HASH_TABLE_SIZE)
-	{
-		if (ptr_array[i].user_ptr != NULL)
-		{
-			count++;
-			bytes += ptr_array[i].size;
-		}
-		i++;
-	}
-	if (count > HASH_TABLE_SIZE * 0.9)
-		ft_putstr_fd_sa(WARN_NEAR_ALLOC_LIMIT, STDOUT_FILENO);
-	return (bytes);
-}
-
 void	*free_specific(
-	t_allocation *ptr_array, const void *ptr, void **double_ptr, size_t *size)
+	t_tracker *tracker, const void *ptr, void **double_ptr, size_t *size)
 {
 	int	count;
 
 	count = 0;
 	if (!ptr && !double_ptr)
-		return (ft_putstr_fd_sa(WARN_FREE_NULL_PTR, STDERR_FILENO), NULL);
+		return (diag_msg_sa(WARN_FREE_NULL_PTR), NULL);
 	if (ptr && double_ptr)
-		return (ft_putstr_fd_sa(WARN_BOTH_PTR, STDERR_FILENO), NULL);
+		return (diag_msg_sa(WARN_BOTH_PTR), NULL);
 	if (ptr)
 	{
 		if (MEMORY_FENCING)
-			return (free_one_memfen(ptr_array, ptr));
+			return (free_one_memfen(tracker, ptr));
 		else if (!MEMORY_FENCING)
-			return (free_one(ptr_array, ptr));
+			return (free_one(tracker, ptr));
 	}
 	if (size)
 		count = *size;
 	if (double_ptr)
-		return (free_list(ptr_array, double_ptr, count));
+		return (free_list(tracker, double_ptr, count));
 	return (NULL);
 }
 
-void	*free_all(t_allocation *ptr_array)
+/*
+** Alignments past BLOCK_ALIGN over-allocate by align bytes and move the
+** user pointer up, see align_block_sa().
+*/
+int	new_block_sa(t_allocation *entry, size_t bytes, size_t align, bool zero)
 {
-	int	i;
+	unsigned char	*block;
+	size_t			extra;
 
-	i = 0;
-	while (i < HASH_TABLE_SIZE)
+	extra = (align > BLOCK_ALIGN) * align;
+	if (bytes > SIZE_MAX - BLOCK_OVERHEAD - extra)
+		return (ERROR);
+	block = block_alloc_sa(bytes + BLOCK_OVERHEAD + extra, zero);
+	if (!block)
+		return (ERROR);
+	entry->original_ptr = block;
+	entry->user_ptr = align_block_sa(block, align);
+	entry->size = bytes;
+	if (ALLOC_SITES || HEAP_PROFILE)
+		site_tag_sa(entry);
+	if (MEMORY_FENCING && !page_guarded_sa(bytes + BLOCK_OVERHEAD + extra))
+		setup_memfen((unsigned char *)entry->user_ptr - GUARD_SIZE, bytes);
+	if (MEMORY_FENCING && FENCE_SCRUB)
 	{
-		if (ptr_array[i].user_ptr)
-		{
-			if (MEMORY_FENCING)
-			{
-				check_memfen(ptr_array[i].user_ptr, ptr_array[i].size);
-				free(ptr_array[i].original_ptr);
-			}
-			else
-				free(ptr_array[i].user_ptr);
-			ft_memset_sa(&ptr_array[i], 0, sizeof(t_allocation));
-		}
-		i++;
+		scrub_start_sa();
+		scrub_stamp_sa(entry, scrub_now_sa());
 	}
-	return (NULL);
+	if (INLINE_HEADER)
+		header_init_sa((unsigned char *)entry->user_ptr - BLOCK_PREFIX,
+			entry->user_ptr, bytes);
+	return (SUCCESS);
 }
 
-void	*allocate_ptr(size_t *size, t_allocation *ptr_array)
+void	*allocate_ptr(
+	size_t *size, t_tracker *tracker, size_t align, bool zero)
 {
-	void	*user_ptr;
-	void	*original_ptr;
+	t_allocation	entry;
 
-	if (MEMORY_FENCING)
-	{
-		original_ptr = ft_calloc_sa(1, (size[0] * size[1]) + (GUARD_SIZE * 2));
-		if (!original_ptr)
-			return (error_cleanup_sa(ptr_array));
-		user_ptr = setup_memfen(original_ptr, size[0] * size[1]);
-		if (add_to_tracking(ptr_array, original_ptr, user_ptr, size) == ERROR)
-			return (free(original_ptr), error_cleanup_sa(ptr_array));
-	}
-	else if (!MEMORY_FENCING)
-	{
-		user_ptr = ft_calloc_sa(size[0], size[1]);
-		if (!user_ptr)
-			return (error_cleanup_sa(ptr_array));
-		if (add_to_tracking(ptr_array, NULL, user_ptr, size) == ERROR)
-			return (free(user_ptr), error_cleanup_sa(ptr_array));
-	}
-	return (user_ptr);
+	if (size[1] != 0 && size[0] > (SIZE_MAX - BLOCK_OVERHEAD) / size[1])
+		return (error_cleanup_sa(tracker));
+	if (new_block_sa(&entry, size[0] * size[1], align, zero) == ERROR)
+		return (error_cleanup_sa(tracker));
+	if (HEAP_PROFILE)
+		sample_take_sa(&entry);
+	if (track_sa(tracker, &entry) == SUCCESS)
+		return (entry.user_ptr);
+	if (HEAP_PROFILE)
+		sample_release_sa(&entry);
+	block_free_sa(entry.original_ptr, block_total_sa(&entry));
+	return (error_cleanup_sa(tracker));
 }
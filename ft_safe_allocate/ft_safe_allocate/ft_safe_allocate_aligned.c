@@ -0,0 +1,52 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_aligned.c                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 17:31:47 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 17:31:47 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+/*
+** The block comes BLOCK_ALIGN aligned and BLOCK_PREFIX is a multiple of
+** it, so rounding up moves the user pointer by at least one word and at
+** most align bytes: the word just in front of the prefix is always free
+** to hold the extra size.
+*/
+unsigned char	*align_block_sa(unsigned char *block, size_t align)
+{
+	unsigned char	*user;
+
+	if (align <= BLOCK_ALIGN)
+		return (block + BLOCK_PREFIX);
+	user = (unsigned char *)(((uintptr_t)block + BLOCK_PREFIX
+				+ sizeof(size_t) + align - 1) & ~(uintptr_t)(align - 1));
+	((size_t *)(user - BLOCK_PREFIX))[-1] = align;
+	return (user);
+}
+
+size_t	block_total_sa(const t_allocation *entry)
+{
+	const unsigned char	*base;
+
+	base = (const unsigned char *)entry->user_ptr - BLOCK_PREFIX;
+	if (!entry->original_ptr || base == entry->original_ptr)
+		return (entry->size + BLOCK_OVERHEAD);
+	return (entry->size + BLOCK_OVERHEAD + ((const size_t *)base)[-1]);
+}
+
+void	*allocate_aligned(size_t *size, t_tracker *tracker)
+{
+	if (!size || size[2] == 0 || (size[2] & (size[2] - 1)) != 0
+		|| size[2] > (size_t)sysconf(_SC_PAGESIZE))
+	{
+		diag_msg_sa(WARN_BAD_ALIGNMENT);
+		return (NULL);
+	}
+	return (allocate_ptr(size, tracker, size[2], true));
+}
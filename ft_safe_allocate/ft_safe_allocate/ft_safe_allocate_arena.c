@@ -0,0 +1,111 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_arena.c                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 13:26:27 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 14:16:52 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+static t_arena_chunk	*new_chunk(t_arena *arena, size_t total)
+{
+	t_arena_chunk	*chunk;
+	size_t			capacity;
+
+	capacity = ARENA_CHUNK_SIZE;
+	if (total > capacity)
+		capacity = total;
+	chunk = RAW_MALLOC(sizeof(t_arena_chunk) + capacity);
+	if (!chunk)
+		return (NULL);
+	chunk->next = arena->chunks;
+	chunk->capacity = capacity;
+	chunk->used = 0;
+	arena->chunks = chunk;
+	return (chunk);
+}
+
+/*
+** Bytes a block of the given user size takes in its chunk. Zero-sized
+** blocks still take one step so every allocation gets its own address.
+*/
+static size_t	block_span(size_t bytes)
+{
+	if (bytes == 0)
+		bytes = 1;
+	return ((ARENA_OVERHEAD + bytes + ARENA_ALIGN - 1)
+		/ ARENA_ALIGN * ARENA_ALIGN);
+}
+
+void	*arena_allocate(t_arena *arena, size_t *size, t_tracker *tracker)
+{
+	t_arena_chunk	*chunk;
+	unsigned char	*block;
+	size_t			bytes;
+	size_t			total;
+
+	if (!arena || !size || (size[1] != 0
+			&& size[0] > (SIZE_MAX - ARENA_OVERHEAD - ARENA_ALIGN) / size[1]))
+		return (NULL);
+	bytes = size[0] * size[1];
+	total = block_span(bytes);
+	chunk = arena->chunks;
+	if (!chunk || chunk->capacity - chunk->used < total)
+		chunk = new_chunk(arena, total);
+	if (!chunk)
+		return (error_cleanup_sa(tracker));
+	block = (unsigned char *)(chunk + 1) + chunk->used;
+	chunk->used += total;
+	ft_memset_sa(block, 0, total);
+	arena->blocks++;
+	arena->bytes += bytes;
+	stats_add_sa(1, bytes);
+	if (!MEMORY_FENCING)
+		return (block);
+	*(size_t *)block = bytes;
+	return (setup_memfen(block + sizeof(size_t), bytes));
+}
+
+/*
+** In fencing builds every block starts with its size, which is enough to
+** walk the chunk block by block and check each pair of guards.
+*/
+static void	check_chunk(t_arena_chunk *chunk)
+{
+	unsigned char	*block;
+	size_t			bytes;
+
+	block = (unsigned char *)(chunk + 1);
+	while (block < (unsigned char *)(chunk + 1) + chunk->used)
+	{
+		bytes = *(size_t *)block;
+		check_memfen(block + ARENA_PREFIX, bytes);
+		block += block_span(bytes);
+	}
+}
+
+void	*arena_end(t_arena *arena)
+{
+	t_arena_chunk	*chunk;
+	t_arena_chunk	*next;
+
+	if (!arena)
+		return (NULL);
+	chunk = arena->chunks;
+	while (chunk)
+	{
+		next = chunk->next;
+		if (MEMORY_FENCING)
+			check_chunk(chunk);
+		RAW_FREE(chunk);
+		chunk = next;
+	}
+	stats_remove_sa(arena->blocks, arena->bytes);
+	RAW_FREE(arena);
+	return (NULL);
+}
@@ -0,0 +1,99 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_avx2.c                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 13:56:05 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 13:56:05 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+#if SIMD_MEMOPS
+
+# include <immintrin.h>
+
+static __m256i	*next_vector(void *b)
+{
+	return ((__m256i *)(((uintptr_t)b + sizeof(__m256i))
+		& ~(uintptr_t)(sizeof(__m256i) - 1)));
+}
+
+__attribute__((target("avx2")))
+static void	set_vectors(__m256i *vd, __m256i v, size_t count)
+{
+	while (count >= 4)
+	{
+		_mm256_store_si256(vd, v);
+		_mm256_store_si256(vd + 1, v);
+		_mm256_store_si256(vd + 2, v);
+		_mm256_store_si256(vd + 3, v);
+		vd += 4;
+		count -= 4;
+	}
+	while (count-- > 0)
+		_mm256_store_si256(vd++, v);
+}
+
+__attribute__((target("avx2")))
+static void	copy_vectors(__m256i *vd, const __m256i *vs, size_t count)
+{
+	while (count >= 4)
+	{
+		_mm256_store_si256(vd, _mm256_loadu_si256(vs));
+		_mm256_store_si256(vd + 1, _mm256_loadu_si256(vs + 1));
+		_mm256_store_si256(vd + 2, _mm256_loadu_si256(vs + 2));
+		_mm256_store_si256(vd + 3, _mm256_loadu_si256(vs + 3));
+		vd += 4;
+		vs += 4;
+		count -= 4;
+	}
+	while (count-- > 0)
+		_mm256_store_si256(vd++, _mm256_loadu_si256(vs++));
+}
+
+/*
+** Same shape as sse2_memset_sa() with 32-byte vectors.
+*/
+__attribute__((target("avx2")))
+void	*avx2_memset_sa(void *b, int c, size_t len)
+{
+	unsigned char	*end;
+	__m256i			*vd;
+	__m256i			v;
+
+	if (len < sizeof(__m256i))
+		return (word_memset_sa(b, c, len));
+	end = (unsigned char *)b + len;
+	v = _mm256_set1_epi8((char)c);
+	_mm256_storeu_si256(b, v);
+	vd = next_vector(b);
+	set_vectors(vd, v, (end - (unsigned char *)vd) / sizeof(__m256i));
+	_mm256_storeu_si256((__m256i *)end - 1, v);
+	return (b);
+}
+
+__attribute__((target("avx2")))
+void	*avx2_memcpy_sa(void *dst, const void *src, size_t n)
+{
+	const unsigned char	*s;
+	__m256i				*vd;
+	size_t				skip;
+
+	if (n < sizeof(__m256i))
+		return (word_memcpy_sa(dst, src, n));
+	s = src;
+	_mm256_storeu_si256(dst, _mm256_loadu_si256(src));
+	vd = next_vector(dst);
+	skip = (unsigned char *)vd - (unsigned char *)dst;
+	copy_vectors(vd, (const __m256i *)(s + skip),
+		(n - skip) / sizeof(__m256i));
+	_mm256_storeu_si256((__m256i *)((unsigned char *)dst + n) - 1,
+		_mm256_loadu_si256((const __m256i *)(s + n) - 1));
+	return (dst);
+}
+
+#endif
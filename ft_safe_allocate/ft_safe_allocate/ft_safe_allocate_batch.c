@@ -0,0 +1,105 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_batch.c                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 14:05:41 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 18:25:38 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+t_allocation	*batch_entries_sa(size_t n, t_allocation *stack)
+{
+	if (n <= BATCH_CHUNK)
+		return (stack);
+	if (n > SIZE_MAX / sizeof(t_allocation))
+		return (NULL);
+	return (RAW_MALLOC(n * sizeof(t_allocation)));
+}
+
+/*
+** Gives back blocks the tracker does not hold, undoing their accounting.
+** With a NULL tracker the batch is still being filled: no block is
+** tracked and the stats counters have not been bumped yet.
+*/
+static void	release_batch(t_tracker *tracker, t_allocation *entries,
+	size_t n)
+{
+	t_allocation	gone;
+	size_t			total;
+	size_t			i;
+
+	total = 0;
+	i = 0;
+	while (i < n)
+	{
+		if (tracker)
+			untrack_sa(tracker, entries[i].user_ptr, &gone);
+		if (ALLOC_SITES)
+			site_account_sa(&entries[i], false);
+		header_clear_sa(&entries[i]);
+		total += entries[i].size;
+		block_free_sa(entries[i].original_ptr,
+			entries[i].size + BLOCK_OVERHEAD);
+		i++;
+	}
+	if (tracker)
+		stats_remove_sa(n, total);
+}
+
+/*
+** Every block is allocated before any is tracked. The counters are bumped
+** once for the whole batch, still before the entries become visible.
+*/
+static int	fill_batch(t_allocation *entries, const size_t *size,
+	const size_t *sizes, void **out)
+{
+	size_t	bytes;
+	size_t	total;
+	size_t	i;
+
+	total = 0;
+	i = 0;
+	while (i < size[0])
+	{
+		bytes = size[1];
+		if (sizes)
+			bytes = sizes[i];
+		if (new_block_sa(&entries[i], bytes, BLOCK_ALIGN, true) == ERROR)
+			return (release_batch(NULL, entries, i), ERROR);
+		out[i] = entries[i].user_ptr;
+		if (ALLOC_SITES)
+			site_account_sa(&entries[i], true);
+		total += entries[i++].size;
+	}
+	stats_add_sa(size[0], total);
+	return (SUCCESS);
+}
+
+void	*allocate_batch(size_t *size, const size_t *sizes, void **out,
+	t_tracker *tracker)
+{
+	t_allocation	stack[BATCH_CHUNK];
+	t_allocation	*entries;
+	int				status;
+
+	if (!size || !out)
+		return (NULL);
+	entries = batch_entries_sa(size[0], stack);
+	status = ERROR;
+	if (entries && fill_batch(entries, size, sizes, out) == SUCCESS)
+	{
+		status = tracker_insert_batch_sa(tracker, entries, size[0]);
+		if (status == ERROR)
+			release_batch(tracker, entries, size[0]);
+	}
+	if (entries != stack)
+		RAW_FREE(entries);
+	if (status == ERROR)
+		return (error_cleanup_sa(tracker));
+	return (out);
+}
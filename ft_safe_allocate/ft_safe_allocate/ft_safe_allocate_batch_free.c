@@ -0,0 +1,92 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_batch_free.c                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 14:06:45 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 17:16:11 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+/*
+** Recent allocations of this thread wait in its magazine; merging them
+** first lets the batch find them in the shards.
+*/
+static void	flush_own_magazine(t_tracker *tracker)
+{
+	t_magazine	*magazine;
+
+	magazine = magazine_sa();
+	if (!magazine)
+		return ;
+	pthread_mutex_lock(&magazine->lock);
+	magazine_flush_sa(tracker, magazine, !magazine->young);
+	magazine_flush_sa(tracker, magazine, magazine->young);
+	pthread_mutex_unlock(&magazine->lock);
+}
+
+static void	release_entry(t_allocation *entry)
+{
+	if (ALLOC_SITES)
+		site_account_sa(entry, false);
+	if (HEAP_PROFILE)
+		sample_release_sa(entry);
+	header_clear_sa(entry);
+	if (MEMORY_FENCING && !page_guarded_sa(block_total_sa(entry)))
+		check_memfen(entry->user_ptr, entry->size);
+	release_block_sa(entry);
+}
+
+static void	release_batch(t_allocation *entries, void **ptrs, size_t n,
+	t_tracker *tracker)
+{
+	size_t	count;
+	size_t	bytes;
+	size_t	i;
+
+	count = 0;
+	bytes = 0;
+	i = -1;
+	while (++i < n)
+	{
+		if (entries && entries[i].user_ptr)
+		{
+			count++;
+			bytes += entries[i].size;
+			release_entry(&entries[i]);
+		}
+		else if (ptrs[i])
+			free_specific(tracker, ptrs[i], NULL, NULL);
+		ptrs[i] = NULL;
+	}
+	stats_remove_sa(count, bytes);
+}
+
+void	*free_batch(size_t *size, void **ptrs, t_tracker *tracker)
+{
+	t_allocation	stack[BATCH_CHUNK];
+	t_allocation	*entries;
+	size_t			i;
+
+	if (!size || !ptrs)
+		return (NULL);
+	if (THREAD_MAGAZINES)
+		flush_own_magazine(tracker);
+	entries = batch_entries_sa(size[0], stack);
+	i = 0;
+	while (entries && i < size[0])
+	{
+		entries[i].user_ptr = ptrs[i];
+		i++;
+	}
+	if (entries)
+		tracker_remove_batch_sa(tracker, entries, size[0]);
+	release_batch(entries, ptrs, size[0], tracker);
+	if (entries != stack)
+		RAW_FREE(entries);
+	return (NULL);
+}
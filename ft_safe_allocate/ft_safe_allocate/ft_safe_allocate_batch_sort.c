@@ -0,0 +1,130 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_batch_sort.c                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 14:05:42 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 19:21:04 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+#if !LOCK_FREE_TRACKING
+
+/*
+** bounds[0] gets the first free position of each digit and bounds[1] the
+** end of its range.
+*/
+static void	count_keys(const t_batch_key *keys, size_t n, size_t radix,
+	size_t bounds[2][BATCH_RADIX])
+{
+	size_t	sum;
+	size_t	b;
+
+	ft_memset_sa(bounds[1], 0, radix * sizeof(size_t));
+	while (n-- > 0)
+		bounds[1][keys[n].key]++;
+	sum = 0;
+	b = 0;
+	while (b < radix)
+	{
+		bounds[0][b] = sum;
+		sum += bounds[1][b];
+		bounds[1][b++] = sum;
+	}
+}
+
+/*
+** One in-place radix pass: each key is swapped straight into the next
+** free position of its digit, so the sort is O(n) and needs no buffer.
+** The shard pass only has SHARD_COUNT digits, which keeps a magazine
+** merge of a few dozen entries from sweeping all BATCH_RADIX of them.
+*/
+static void	radix_sort(t_batch_key *keys, size_t n, size_t radix)
+{
+	size_t		bounds[2][BATCH_RADIX];
+	size_t		*next;
+	t_batch_key	tmp;
+	size_t		b;
+
+	count_keys(keys, n, radix, bounds);
+	next = bounds[0];
+	b = 0;
+	while (b < radix)
+	{
+		if (next[b] == bounds[1][b])
+			b++;
+		else if (keys[next[b]].key == b)
+			next[b]++;
+		else
+		{
+			tmp = keys[next[b]];
+			keys[next[b]] = keys[next[tmp.key]];
+			keys[next[tmp.key]++] = tmp;
+		}
+	}
+}
+
+t_batch_key	*batch_keys_sa(t_tracker *tracker,
+	const t_allocation *entries, size_t n, t_batch_key *stack)
+{
+	t_batch_key	*keys;
+	size_t		i;
+
+	keys = stack;
+	if (n > BATCH_CHUNK && n <= SIZE_MAX / sizeof(t_batch_key))
+		keys = RAW_MALLOC(n * sizeof(t_batch_key));
+	else if (n > BATCH_CHUNK)
+		keys = NULL;
+	if (!keys)
+		return (NULL);
+	i = 0;
+	while (i < n)
+	{
+		keys[i].key = shard_for_sa(tracker, entries[i].user_ptr)
+			- tracker->shards;
+		keys[i].index = i;
+		i++;
+	}
+	radix_sort(keys, n, SHARD_COUNT);
+	return (keys);
+}
+
+/*
+** Linear probing walks up from the home bucket, so handling a shard's
+** entries in order of their top bucket bits sweeps its slot array once,
+** front to back. Short runs touch too few slots for the pass to pay off.
+*/
+void	batch_sort_run_sa(t_table *table,
+	const t_allocation *entries, t_batch_key *run, size_t m)
+{
+	size_t	shift;
+	size_t	i;
+
+	if (m < BATCH_RADIX)
+		return ;
+	shift = 0;
+	while ((table->capacity - 1) >> shift >= BATCH_RADIX)
+		shift++;
+	i = 0;
+	while (i < m)
+	{
+		run[i].key = (hash_ptr(entries[run[i].index].user_ptr)
+				& (table->capacity - 1)) >> shift;
+		i++;
+	}
+	radix_sort(run, m, BATCH_RADIX);
+}
+
+#endif
+
+int	table_reserve_sa(t_table *table, size_t extra)
+{
+	if ((table->count + table->pending + extra) * 100
+		<= table->capacity * TABLE_MAX_LOAD)
+		return (SUCCESS);
+	return (table_grow_sa(table, extra));
+}
@@ -0,0 +1,123 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_block.c                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 13:06:26 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 19:21:04 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+/*
+** The counters are bumped before the entry becomes visible, so a free
+** racing with this insert can never take live_blocks below zero.
+*/
+int	track_sa(t_tracker *tracker, const t_allocation *entry)
+{
+	int	status;
+
+	stats_add_sa(1, entry->size);
+	if (ALLOC_SITES)
+		site_account_sa(entry, true);
+	if (THREAD_MAGAZINES)
+		status = magazine_insert_sa(tracker, entry);
+	else
+		status = tracker_insert_sa(tracker, entry);
+	if (status == ERROR)
+		stats_remove_sa(1, entry->size);
+	if (ALLOC_SITES && status == ERROR)
+		site_account_sa(entry, false);
+	return (status);
+}
+
+int	forget_sa(t_tracker *tracker, const void *ptr, t_allocation *entry)
+{
+	int	status;
+
+	if (THREAD_MAGAZINES)
+		status = magazine_remove_sa(tracker, ptr, entry);
+	else
+		status = untrack_sa(tracker, ptr, entry);
+	if (status == SUCCESS)
+	{
+		stats_remove_sa(1, entry->size);
+		if (ALLOC_SITES)
+			site_account_sa(entry, false);
+		if (HEAP_PROFILE)
+			sample_release_sa(entry);
+		header_clear_sa(entry);
+	}
+	return (status);
+}
+
+static void	*reuse_cached(t_magazine *magazine, size_t total)
+{
+	void	*block;
+	size_t	i;
+
+	block = NULL;
+	i = magazine->ncache;
+	while (i-- > 0 && !block)
+	{
+		if (magazine->cache[i].size == total)
+		{
+			block = magazine->cache[i].original_ptr;
+			magazine->cache[i] = magazine->cache[--magazine->ncache];
+		}
+	}
+	return (block);
+}
+
+void	*block_alloc_sa(size_t total, bool zero)
+{
+	t_magazine	*magazine;
+	void		*block;
+
+	block = NULL;
+	magazine = NULL;
+	if (THREAD_MAGAZINES && total <= MAGAZINE_MAX_BLOCK)
+		magazine = magazine_sa();
+	if (magazine)
+		block = reuse_cached(magazine, total);
+	if (block && zero)
+		return (ft_memset_sa(block, 0, total));
+	if (block)
+		return (block);
+	if (SLAB_ALLOCATOR && total <= SLAB_MAX_BLOCK)
+		return (slab_alloc_sa(total, zero));
+	if (page_guarded_sa(total))
+		return (guard_map_sa(total));
+	if (total >= MMAP_MIN_BLOCK)
+		return (mmap_block_sa(total));
+	if (zero)
+		return (ft_calloc_sa(1, total));
+	return (RAW_MALLOC(total));
+}
+
+void	release_block_sa(const t_allocation *entry)
+{
+	t_magazine	*magazine;
+	size_t		total;
+	bool		cached;
+
+	total = block_total_sa(entry);
+	magazine = NULL;
+	cached = false;
+	if (THREAD_MAGAZINES && entry->original_ptr && total <= MAGAZINE_MAX_BLOCK)
+		magazine = magazine_sa();
+	if (magazine)
+		cached = magazine->ncache < MAGAZINE_CACHE;
+	if (cached)
+	{
+		magazine->cache[magazine->ncache].original_ptr = entry->original_ptr;
+		magazine->cache[magazine->ncache++].size = total;
+	}
+	if (!cached && entry->original_ptr)
+		block_free_sa(entry->original_ptr, total);
+	else if (!cached)
+		free(entry->user_ptr);
+}
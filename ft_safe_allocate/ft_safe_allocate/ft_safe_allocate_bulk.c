@@ -0,0 +1,54 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_bulk.c                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 12:47:42 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 19:21:04 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+static void	release_slot(t_allocation *slot, void *arg)
+{
+	(void)arg;
+	stats_remove_sa(1, slot->size);
+	if (ALLOC_SITES)
+		site_account_sa(slot, false);
+	if (HEAP_PROFILE)
+		sample_release_sa(slot);
+	header_clear_sa(slot);
+	if (MEMORY_FENCING && !page_guarded_sa(block_total_sa(slot)))
+		check_memfen(slot->user_ptr, slot->size);
+	if (slot->original_ptr)
+		block_free_sa(slot->original_ptr, block_total_sa(slot));
+	else
+		free(slot->user_ptr);
+}
+
+/*
+** Blocks cached for reuse are not allocations; only the caller's own cache
+** can be emptied, since its owner reads it without a lock.
+*/
+void	*free_all(t_tracker *tracker)
+{
+	t_magazine	*magazine;
+
+	if (THREAD_MAGAZINES)
+	{
+		magazine_lock_all_sa();
+		magazine_drain_sa(release_slot, NULL);
+	}
+	tracker_drain_sa(tracker, release_slot, NULL);
+	if (THREAD_MAGAZINES)
+		magazine_unlock_all_sa();
+	magazine = NULL;
+	if (THREAD_MAGAZINES)
+		magazine = *magazine_own_sa();
+	if (magazine)
+		magazine_purge_sa(magazine);
+	return (NULL);
+}
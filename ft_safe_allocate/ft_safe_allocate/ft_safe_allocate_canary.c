@@ -0,0 +1,82 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_canary.c                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 17:02:10 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 17:02:10 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+static uint64_t	*secret_storage(void)
+{
+	static uint64_t	secret;
+
+	return (&secret);
+}
+
+/*
+** Without getrandom() the secret still differs between runs through ASLR
+** and the clock, which is enough against accidental matches.
+*/
+static void	init_secret(void)
+{
+	uint64_t		*secret;
+	struct timespec	now;
+
+	secret = secret_storage();
+	if (getrandom(secret, sizeof(*secret), GRND_NONBLOCK)
+		== (ssize_t) sizeof(*secret))
+		return ;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	*secret = hash_ptr((void *)((uintptr_t)&now ^ (uintptr_t)now.tv_nsec));
+}
+
+uint64_t	canary_sa(const void *guard)
+{
+	static pthread_once_t	once = PTHREAD_ONCE_INIT;
+
+	pthread_once(&once, init_secret);
+	return (hash_ptr((const void *)((uintptr_t)guard ^ *secret_storage())));
+}
+
+unsigned char	*end_guard_sa(const void *user_ptr, size_t size)
+{
+	return ((unsigned char *)(((uintptr_t)user_ptr + size + GUARD_SIZE - 1)
+		& ~(uintptr_t)(GUARD_SIZE - 1)));
+}
+
+bool	start_intact_sa(const void *user_ptr)
+{
+	const unsigned char	*guard;
+
+	guard = (const unsigned char *)user_ptr - GUARD_SIZE;
+	return (*(const t_word *)guard == canary_sa(guard));
+}
+
+/*
+** The padding in front of the end guard holds the canary's bytes at the
+** same offsets, so it is checked with the word it shares with the last
+** user bytes, masked to its high (little-endian: last) bytes.
+*/
+bool	end_intact_sa(const void *user_ptr, size_t size)
+{
+	const unsigned char	*guard;
+	uint64_t			canary;
+	size_t				pad;
+	uint64_t			mask;
+
+	guard = end_guard_sa(user_ptr, size);
+	canary = canary_sa(guard);
+	if (*(const t_word *)guard != canary)
+		return (false);
+	pad = guard - ((const unsigned char *)user_ptr + size);
+	if (pad == 0)
+		return (true);
+	mask = ~0ULL << (8 * (GUARD_SIZE - pad));
+	return (((*(const t_word *)(guard - GUARD_SIZE) ^ canary) & mask) == 0);
+}
@@ -0,0 +1,47 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_diag.c                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 14:53:40 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 14:53:40 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+static t_diag	*diag_storage(void)
+{
+	static t_diag	diag;
+
+	return (&diag);
+}
+
+static void	init_diag(void)
+{
+	t_diag	*diag;
+	size_t	i;
+
+	diag = diag_storage();
+	i = 0;
+	while (i < DIAG_SLOTS)
+	{
+		atomic_init(&diag->slots[i].seq, i);
+		i++;
+	}
+	pthread_mutex_init(&diag->flush_lock, NULL);
+	diag->fd = DIAG_FD;
+	pthread_atfork(diag_fork_prepare_sa, diag_fork_parent_sa,
+		diag_fork_child_sa);
+	atexit(diag_exit_sa);
+}
+
+t_diag	*diag_sa(void)
+{
+	static pthread_once_t	once = PTHREAD_ONCE_INIT;
+
+	pthread_once(&once, init_diag);
+	return (diag_storage());
+}
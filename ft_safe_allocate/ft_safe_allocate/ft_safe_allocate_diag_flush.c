@@ -0,0 +1,101 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_diag_flush.c                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 14:53:40 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 14:53:40 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+static void	write_lines(int fd, struct iovec *iov, int count)
+{
+	ssize_t	done;
+
+	while (count > 0)
+	{
+		done = writev(fd, iov, count);
+		if (done < 0)
+			return ;
+		while (count > 0 && (size_t)done >= iov->iov_len)
+		{
+			done -= iov->iov_len;
+			iov++;
+			count--;
+		}
+		if (count > 0)
+		{
+			iov->iov_base = (char *)iov->iov_base + done;
+			iov->iov_len -= done;
+		}
+	}
+}
+
+static size_t	collect(t_diag *diag, struct iovec *iov)
+{
+	t_diag_slot	*slot;
+	size_t		n;
+
+	n = 0;
+	while (n < DIAG_SLOTS)
+	{
+		slot = &diag->slots[(diag->tail + n) & (DIAG_SLOTS - 1)];
+		if (atomic_load_explicit(&slot->seq, memory_order_acquire)
+			!= diag->tail + n + 1)
+			break ;
+		iov[n].iov_base = slot->text;
+		iov[n].iov_len = slot->len;
+		n++;
+	}
+	return (n);
+}
+
+static void	report_dropped(t_diag *diag)
+{
+	char	line[DIAG_LINE];
+	size_t	dropped;
+	size_t	len;
+
+	dropped = atomic_load_explicit(&diag->dropped, memory_order_relaxed);
+	if (dropped == diag->reported)
+		return ;
+	len = diag_cat_sa(line, 0, WARN_DIAG_DROPPED_1);
+	len = diag_num_sa(line, len, dropped - diag->reported, 10);
+	len = diag_cat_sa(line, len, WARN_DIAG_DROPPED_2);
+	diag->reported = dropped;
+	write(diag->fd, line, len);
+}
+
+void	diag_drain_sa(t_diag *diag)
+{
+	struct iovec	iov[DIAG_SLOTS];
+	size_t			n;
+	size_t			i;
+
+	n = collect(diag, iov);
+	write_lines(diag->fd, iov, n);
+	i = 0;
+	while (i < n)
+	{
+		atomic_store_explicit(
+			&diag->slots[(diag->tail + i) & (DIAG_SLOTS - 1)].seq,
+			diag->tail + i + DIAG_SLOTS, memory_order_release);
+		i++;
+	}
+	diag->tail += n;
+	report_dropped(diag);
+}
+
+void	diag_flush_sa(void)
+{
+	t_diag	*diag;
+
+	diag = diag_sa();
+	pthread_mutex_lock(&diag->flush_lock);
+	diag_drain_sa(diag);
+	pthread_mutex_unlock(&diag->flush_lock);
+}
@@ -0,0 +1,64 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_diag_format.c                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 14:53:40 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 14:53:40 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+size_t	diag_cat_sa(char *line, size_t len, const char *s)
+{
+	while (s && *s && len < DIAG_LINE)
+		line[len++] = *s++;
+	return (len);
+}
+
+size_t	diag_num_sa(char *line, size_t len, size_t n, size_t base)
+{
+	char	digits[sizeof(size_t) * 8];
+	size_t	count;
+
+	count = 0;
+	while (count == 0 || n)
+	{
+		digits[count++] = "0123456789abcdef"[n % base];
+		n /= base;
+	}
+	while (count && len < DIAG_LINE)
+		line[len++] = digits[--count];
+	return (len);
+}
+
+/*
+** A line cut at DIAG_LINE bytes still ends the way the message did.
+*/
+static void	push_line(char *line, size_t len)
+{
+	if (len == DIAG_LINE)
+		line[DIAG_LINE - 1] = '\n';
+	diag_push_sa(line, len);
+}
+
+void	diag_msg_sa(const char *msg)
+{
+	char	line[DIAG_LINE];
+
+	push_line(line, diag_cat_sa(line, 0, msg));
+}
+
+void	diag_ptr_sa(const char *head, const void *ptr, const char *tail)
+{
+	char	line[DIAG_LINE];
+	size_t	len;
+
+	len = diag_cat_sa(line, 0, head);
+	len = diag_num_sa(line, len, (uintptr_t)ptr, 16);
+	len = diag_cat_sa(line, len, tail);
+	push_line(line, len);
+}
@@ -0,0 +1,51 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_diag_hooks.c                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 14:53:40 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 14:53:40 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+void	diag_fork_prepare_sa(void)
+{
+	t_diag	*diag;
+
+	diag = diag_sa();
+	pthread_mutex_lock(&diag->flush_lock);
+	diag_drain_sa(diag);
+}
+
+void	diag_fork_parent_sa(void)
+{
+	pthread_mutex_unlock(&diag_sa()->flush_lock);
+}
+
+void	diag_fork_child_sa(void)
+{
+	t_diag	*diag;
+
+	diag = diag_sa();
+	atomic_store(&diag->started, false);
+	pthread_mutex_unlock(&diag->flush_lock);
+}
+
+/*
+** Handlers registered with atexit() before diag_sa() first ran are called
+** after this one; what they report is written right away.
+*/
+void	diag_exit_sa(void)
+{
+	t_diag	*diag;
+
+	diag = diag_sa();
+	pthread_mutex_lock(&diag->flush_lock);
+	atomic_store(&diag->direct, true);
+	diag_drain_sa(diag);
+	pthread_mutex_unlock(&diag->flush_lock);
+}
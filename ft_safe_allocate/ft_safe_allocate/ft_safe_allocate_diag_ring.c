@@ -0,0 +1,134 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_diag_ring.c                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 14:53:40 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 14:53:40 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+/*
+** The thread stops once nothing was queued for DIAG_IDLE_TICKS periods.
+** started is cleared before the last flush: a producer that still saw it
+** set had published its line before, so the flush writes it.
+*/
+static void	*flush_loop(void *arg)
+{
+	t_diag			*diag;
+	struct timespec	pause;
+	size_t			seen;
+	size_t			idle;
+
+	diag = arg;
+	pause.tv_sec = DIAG_FLUSH_MS / 1000;
+	pause.tv_nsec = DIAG_FLUSH_MS % 1000 * 1000000L;
+	seen = atomic_load(&diag->head);
+	idle = 0;
+	while (idle < DIAG_IDLE_TICKS)
+	{
+		nanosleep(&pause, NULL);
+		idle++;
+		if (atomic_load(&diag->head) != seen)
+			idle = 0;
+		seen = atomic_load(&diag->head);
+		diag_flush_sa();
+	}
+	atomic_store(&diag->started, false);
+	diag_flush_sa();
+	return (NULL);
+}
+
+static void	start_flusher(t_diag *diag)
+{
+	pthread_t	thread;
+
+	if (!DIAG_FLUSH_THREAD || atomic_load(&diag->started)
+		|| atomic_exchange(&diag->started, true))
+		return ;
+	if (pthread_create(&thread, NULL, flush_loop, diag) != 0)
+	{
+		atomic_store(&diag->started, false);
+		return ;
+	}
+	pthread_detach(thread);
+}
+
+static t_diag_slot	*reserve(t_diag *diag)
+{
+	t_diag_slot	*slot;
+	size_t		pos;
+	size_t		seq;
+
+	pos = atomic_load_explicit(&diag->head, memory_order_relaxed);
+	while (1)
+	{
+		slot = &diag->slots[pos & (DIAG_SLOTS - 1)];
+		seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+		if (seq < pos)
+			return (NULL);
+		if (seq == pos && atomic_compare_exchange_weak_explicit(&diag->head,
+				&pos, pos + 1, memory_order_relaxed, memory_order_relaxed))
+			return (slot);
+		if (seq > pos)
+			pos = atomic_load_explicit(&diag->head, memory_order_relaxed);
+	}
+}
+
+/*
+** The line is published with a sequentially consistent store so that the
+** load of started after it cannot be ordered first (see flush_loop).
+*/
+void	diag_push_sa(const char *text, size_t len)
+{
+	t_diag		*diag;
+	t_diag_slot	*slot;
+
+	diag = diag_sa();
+	if (atomic_load_explicit(&diag->direct, memory_order_relaxed))
+	{
+		pthread_mutex_lock(&diag->flush_lock);
+		diag_drain_sa(diag);
+		write(diag->fd, text, len);
+		pthread_mutex_unlock(&diag->flush_lock);
+		return ;
+	}
+	slot = reserve(diag);
+	if (!slot)
+	{
+		atomic_fetch_add_explicit(&diag->dropped, 1, memory_order_relaxed);
+		return ;
+	}
+	ft_memcpy_sa(slot->text, text, len);
+	slot->len = len;
+	atomic_store(&slot->seq,
+		atomic_load_explicit(&slot->seq, memory_order_relaxed) + 1);
+	start_flusher(diag);
+}
+
+void	*diag_target_sa(size_t *size, const char *path)
+{
+	t_diag	*diag;
+	int		fd;
+
+	diag = diag_sa();
+	fd = DIAG_FD;
+	if (path)
+		fd = open(path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+	else if (size)
+		fd = (int)size[0];
+	if (fd < 0)
+		return (diag_msg_sa(ERR_DIAG_TARGET), NULL);
+	pthread_mutex_lock(&diag->flush_lock);
+	diag_drain_sa(diag);
+	if (diag->owned_fd)
+		close(diag->fd);
+	diag->fd = fd;
+	diag->owned_fd = (path != NULL);
+	pthread_mutex_unlock(&diag->flush_lock);
+	return (NULL);
+}
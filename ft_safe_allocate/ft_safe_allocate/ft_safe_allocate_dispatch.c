@@ -0,0 +1,84 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_dispatch.c                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 18:40:12 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 18:40:12 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+static void	*add_external(size_t *size, t_tracker *tracker, void *ptr)
+{
+	if (MEMORY_FENCING || INLINE_HEADER)
+		return (realloc_ptr(size, tracker, ptr, ADD_TO_TRACK));
+	add_to_tracking(tracker, NULL, ptr, size);
+	return (ptr);
+}
+
+static void	*arena_action(
+	size_t *size, t_action action, void *ptr, t_tracker *tracker)
+{
+	if (action == ARENA_BEGIN)
+		return (ft_calloc_sa(1, sizeof(t_arena)));
+	if (action == ARENA_ALLOCATE)
+		return (arena_allocate((t_arena *)ptr, size, tracker));
+	return (arena_end((t_arena *)ptr));
+}
+
+/*
+** Actions that do not use the tracker directly, and unknown ones.
+*/
+static void	*extended_action(
+	size_t *size, t_action action, void *ptr, void **double_ptr)
+{
+	if (action == GET_STATS)
+		return (get_stats((t_alloc_stats *)ptr));
+	if (action == ALLOCATE_BATCH)
+		return (allocate_batch(size, ptr, double_ptr, tracker_sa()));
+	if (action == FREE_BATCH)
+		return (free_batch(size, double_ptr, tracker_sa()));
+	if (action == DIAG_TARGET)
+		return (diag_target_sa(size, ptr));
+	if (action == GET_PROFILE)
+		return (get_profile_sa((t_profile *)ptr));
+	if (action == GET_SITES)
+		return ((void *)(uintptr_t)get_sites_sa(size, ptr));
+	if (action == LEAK_REPORT)
+		return (leak_action_sa(size, ptr));
+	if (action == SAMPLE_RATE)
+		return (sample_rate_sa(size));
+	if (action == HEAP_DUMP)
+		return (heap_dump_sa(size, ptr));
+	if (action == ALLOCATE_ALIGNED)
+		return (allocate_aligned(size, tracker_sa()));
+	return (NULL);
+}
+
+void	*dispatch_sa(
+	size_t *size, t_action action, void *ptr, void **double_ptr)
+{
+	void		*user_ptr;
+	uint64_t	start;
+
+	start = 0;
+	if (INSTRUMENT)
+		start = instr_clock_sa();
+	if (action == FREE_ALL)
+		user_ptr = free_all(tracker_sa());
+	else if (action == FREE_ONE)
+		user_ptr = free_specific(tracker_sa(), ptr, double_ptr, size);
+	else if (action == ADD_TO_TRACK)
+		user_ptr = add_external(size, tracker_sa(), ptr);
+	else if (action >= ARENA_BEGIN && action <= ARENA_END)
+		user_ptr = arena_action(size, action, ptr, tracker_sa());
+	else
+		user_ptr = extended_action(size, action, ptr, double_ptr);
+	if (INSTRUMENT)
+		instr_action_sa(action, instr_clock_sa() - start);
+	return (user_ptr);
+}
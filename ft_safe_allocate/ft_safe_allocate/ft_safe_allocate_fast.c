@@ -0,0 +1,60 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_fast.c                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 18:40:12 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 18:38:14 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+size_t	hash_ptr(const void *ptr)
+{
+	uintptr_t key;
+	
+	key = (uintptr_t)ptr;
+	key ^= (key >> 33);
+	key *= 0xff51afd7ed558ccd;
+	key ^= (key >> 33);
+	key *= 0xc4ceb9fe1a85ec53;
+	key ^= (key >> 33);
+	return ((size_t)key);
+}
+
+/*
+** NULL is ignored like free(NULL); FREE_ONE warns about it instead.
+*/
+void	sa_free(void *ptr)
+{
+	uint64_t	start;
+
+	if (!ptr)
+		return ;
+	start = 0;
+	if (INSTRUMENT)
+		start = instr_clock_sa();
+	if (MEMORY_FENCING)
+		free_one_memfen(tracker_sa(), ptr);
+	else
+		free_one(tracker_sa(), ptr);
+	if (INSTRUMENT)
+		instr_action_sa(FREE_ONE, instr_clock_sa() - start);
+}
+
+size_t	sa_usage(void)
+{
+	uint64_t	start;
+	size_t		bytes;
+
+	start = 0;
+	if (INSTRUMENT)
+		start = instr_clock_sa();
+	bytes = get_allocation_count(tracker_sa());
+	if (INSTRUMENT)
+		instr_action_sa(GET_USAGE, instr_clock_sa() - start);
+	return (bytes);
+}
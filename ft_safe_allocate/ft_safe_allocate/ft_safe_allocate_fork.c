@@ -0,0 +1,64 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_fork.c                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 21:14:37 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 18:38:04 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+/*
+** Outermost first. The scrubber and the leak report take the magazine
+** locks, magazine locks come before shard locks, and blocks go back to
+** their slab class and heap bucket with those held. Nothing else is
+** locked once heap->lock is.
+*/
+static void	hold_all(void)
+{
+	if (FENCE_SCRUB)
+		pthread_mutex_lock(&scrub_sa()->lock);
+	pthread_mutex_lock(&leak_sa()->lock);
+	if (THREAD_MAGAZINES)
+		magazine_lock_all_sa();
+	tracker_locks_sa(tracker_sa(), pthread_mutex_lock);
+	if (SLAB_ALLOCATOR)
+		slab_locks_sa(pthread_mutex_lock);
+	if (HEAP_PROFILE)
+		pthread_mutex_lock(&heap_sa()->lock);
+}
+
+static void	release_all(void)
+{
+	if (HEAP_PROFILE)
+		pthread_mutex_unlock(&heap_sa()->lock);
+	if (SLAB_ALLOCATOR)
+		slab_locks_sa(pthread_mutex_unlock);
+	tracker_locks_sa(tracker_sa(), pthread_mutex_unlock);
+	if (THREAD_MAGAZINES)
+		magazine_unlock_all_sa();
+	pthread_mutex_unlock(&leak_sa()->lock);
+	if (FENCE_SCRUB)
+		pthread_mutex_unlock(&scrub_sa()->lock);
+}
+
+/*
+** Prepare handlers run in the reverse order of registration: the ring's,
+** registered first, take its flush lock after all of the above.
+*/
+static void	register_handlers(void)
+{
+	diag_sa();
+	pthread_atfork(hold_all, release_all, release_all);
+}
+
+void	fork_handlers_sa(void)
+{
+	static pthread_once_t	once = PTHREAD_ONCE_INIT;
+
+	pthread_once(&once, register_handlers);
+}
@@ -0,0 +1,63 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_guard.c                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 14:03:00 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 17:09:28 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+bool	page_guarded_sa(size_t total)
+{
+	return (MEMORY_FENCING && PAGE_GUARDS && total >= PAGE_GUARD_MIN);
+}
+
+/*
+** Readable bytes between the two guard pages. The block is pushed up
+** against the end one, rounded down to PAGE_GUARD_ALIGN, so that less
+** than PAGE_GUARD_ALIGN bytes separate the user data from the fault.
+** The software end guard would land in the guard page and is not used.
+** Neither is the padding in front of it.
+*/
+static size_t	data_span(size_t total)
+{
+	return (mapped_size_sa(total - GUARD_TAIL + PAGE_GUARD_ALIGN - 1));
+}
+
+void	*guard_map_sa(size_t total)
+{
+	unsigned char	*base;
+	size_t			page;
+	size_t			span;
+
+	page = (size_t)sysconf(_SC_PAGESIZE);
+	span = data_span(total);
+	base = mmap(NULL, span + 2 * page, PROT_NONE,
+			MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (base == MAP_FAILED)
+		return (NULL);
+	if (mprotect(base + page, span, PROT_READ | PROT_WRITE) != 0)
+		return (munmap(base, span + 2 * page), NULL);
+	return ((void *)((uintptr_t)(base + page + span - (total - GUARD_TAIL))
+		& ~(uintptr_t)(PAGE_GUARD_ALIGN - 1)));
+}
+
+/*
+** The end of the readable span is the first page boundary at or after
+** the user data, everything else follows from the block size.
+*/
+void	guard_unmap_sa(void *block, size_t total)
+{
+	unsigned char	*end;
+	size_t			page;
+
+	page = (size_t)sysconf(_SC_PAGESIZE);
+	end = (unsigned char *)mapped_size_sa(
+			(uintptr_t)block + total - GUARD_TAIL);
+	munmap(end - data_span(total) - page, data_span(total) + 2 * page);
+}
@@ -0,0 +1,62 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_header.c                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 13:19:24 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 17:16:11 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+void	header_init_sa(void *block, const void *user_ptr, size_t size)
+{
+	t_header	*header;
+
+	header = block;
+	header->size = size;
+	header->slot = SIZE_MAX;
+	header->magic = HEADER_MAGIC ^ (uintptr_t)user_ptr;
+}
+
+t_header	*header_sa(const void *ptr)
+{
+	t_header	*header;
+
+	header = (t_header *)((uintptr_t)ptr - BLOCK_PREFIX);
+	if (!ptr || (uintptr_t)header > (uintptr_t)ptr
+		|| (uintptr_t)header % _Alignof(t_header) != 0)
+		return (NULL);
+	if (header->magic != (HEADER_MAGIC ^ (uintptr_t)ptr))
+		return (NULL);
+	return (header);
+}
+
+size_t	header_slot_sa(const void *ptr)
+{
+	t_header	*header;
+
+	header = header_sa(ptr);
+	if (!header)
+		return (SIZE_MAX);
+	return (header->slot);
+}
+
+/*
+** Called by the tracker each time it stores an entry in a slot, including
+** when a growth migrates it, so the hint follows the entry around.
+*/
+void	header_set_slot_sa(const t_allocation *entry, size_t slot)
+{
+	if (INLINE_HEADER && entry->original_ptr)
+		((t_header *)((uintptr_t)entry->user_ptr - BLOCK_PREFIX))->slot = slot;
+}
+
+void	header_clear_sa(const t_allocation *entry)
+{
+	if (INLINE_HEADER && entry->original_ptr)
+		((t_header *)((uintptr_t)entry->user_ptr - BLOCK_PREFIX))->magic = 0;
+}
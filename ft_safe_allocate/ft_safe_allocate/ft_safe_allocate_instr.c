@@ -0,0 +1,76 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_instr.c                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 15:08:07 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 15:26:15 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+static t_instr	*instr_storage(void)
+{
+	static t_instr	instr;
+
+	return (&instr);
+}
+
+/*
+** The diagnostics ring registers its own exit handler first, so it runs
+** after the summary and writes it out.
+*/
+static void	init_instr(void)
+{
+	diag_sa();
+	atexit(instr_exit_sa);
+}
+
+t_instr	*instr_sa(void)
+{
+	static pthread_once_t	once = PTHREAD_ONCE_INIT;
+
+	pthread_once(&once, init_instr);
+	return (instr_storage());
+}
+
+void	instr_exit_sa(void)
+{
+	t_profile	profile;
+	char		line[DIAG_LINE];
+	size_t		len;
+
+	get_profile_sa(&profile);
+	diag_flush_sa();
+	instr_report_sa(&profile);
+	len = diag_cat_sa(line, 0, INSTR_PREFIX "shard locks ");
+	len = diag_num_sa(line, len, profile.lock_acquires, 10);
+	len = diag_cat_sa(line, len, ", waited ");
+	len = diag_num_sa(line, len, profile.lock_waits, 10);
+	len = diag_cat_sa(line, len, " for ");
+	len = diag_num_sa(line, len, profile.lock_wait_cycles, 10);
+	len = diag_cat_sa(line, len, " " INSTR_UNIT ", fence checks ");
+	len = diag_num_sa(line, len, profile.fence_checks, 10);
+	len = diag_cat_sa(line, len, " for ");
+	len = diag_num_sa(line, len, profile.fence_cycles, 10);
+	diag_push_sa(line, diag_cat_sa(line, len, " " INSTR_UNIT "\n"));
+}
+
+void	instr_lock_sa(pthread_mutex_t *lock)
+{
+	t_instr		*instr;
+	uint64_t	start;
+
+	instr = instr_sa();
+	atomic_fetch_add_explicit(&instr->lock_acquires, 1, memory_order_relaxed);
+	if (pthread_mutex_trylock(lock) == 0)
+		return ;
+	start = instr_clock_sa();
+	pthread_mutex_lock(lock);
+	atomic_fetch_add_explicit(&instr->lock_waits, 1, memory_order_relaxed);
+	atomic_fetch_add_explicit(&instr->lock_wait_cycles,
+		instr_clock_sa() - start, memory_order_relaxed);
+}
@@ -0,0 +1,81 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_instr_record.c                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 15:08:07 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 15:26:15 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+_Static_assert(sizeof(t_instr) == sizeof(t_profile),
+	"t_instr and t_profile must keep the same layout");
+
+static size_t	bucket(uint64_t cycles)
+{
+	size_t	b;
+
+	b = 0;
+	while (cycles > 1 && b + 1 < INSTR_BUCKETS)
+	{
+		cycles >>= 1;
+		b++;
+	}
+	return (b);
+}
+
+void	instr_action_sa(t_action action, uint64_t cycles)
+{
+	t_instr	*instr;
+
+	if ((unsigned int)action >= ACTION_COUNT)
+		return ;
+	instr = instr_sa();
+	atomic_fetch_add_explicit(&instr->calls[action], 1, memory_order_relaxed);
+	atomic_fetch_add_explicit(
+		&instr->cycles[action], cycles, memory_order_relaxed);
+	atomic_fetch_add_explicit(&instr->latency[action][bucket(cycles)], 1,
+		memory_order_relaxed);
+}
+
+void	instr_probe_sa(int kind, size_t slots)
+{
+	if (slots == 0)
+		slots = 1;
+	if (slots > INSTR_PROBES)
+		slots = INSTR_PROBES;
+	atomic_fetch_add_explicit(&instr_sa()->probes[kind][slots - 1], 1,
+		memory_order_relaxed);
+}
+
+void	instr_fence_sa(uint64_t cycles)
+{
+	t_instr	*instr;
+
+	instr = instr_sa();
+	atomic_fetch_add_explicit(&instr->fence_checks, 1, memory_order_relaxed);
+	atomic_fetch_add_explicit(
+		&instr->fence_cycles, cycles, memory_order_relaxed);
+}
+
+void	*get_profile_sa(t_profile *profile)
+{
+	atomic_size_t	*counters;
+	size_t			i;
+
+	if (!INSTRUMENT || !profile)
+		return (NULL);
+	counters = (atomic_size_t *)instr_sa();
+	i = 0;
+	while (i < sizeof(t_profile) / sizeof(size_t))
+	{
+		((size_t *)profile)[i] = atomic_load_explicit(
+				&counters[i], memory_order_relaxed);
+		i++;
+	}
+	return (profile);
+}
@@ -0,0 +1,112 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_instr_report.c                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 15:08:07 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 17:16:11 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+/*
+** Follows the order of t_action.
+*/
+static const char	*action_name(size_t action)
+{
+	static const char	*names[ACTION_COUNT] = {"ALLOCATE", "FREE_ALL",
+		"FREE_ONE", "GET_USAGE", "REALLOC", "ADD_TO_TRACK", "GET_STATS",
+		"ARENA_BEGIN", "ARENA_ALLOCATE", "ARENA_END", "ALLOCATE_UNINIT",
+		"ALLOCATE_BATCH", "FREE_BATCH", "DIAG_TARGET", "GET_PROFILE",
+		"GET_SITES", "LEAK_REPORT", "SAMPLE_RATE", "HEAP_DUMP",
+		"ALLOCATE_ALIGNED"};
+
+	return (names[action]);
+}
+
+/*
+** Upper bound of the bucket holding the pct-th percentile.
+*/
+static size_t	percentile(const size_t *hist, size_t calls, size_t pct)
+{
+	size_t	seen;
+	size_t	b;
+
+	seen = 0;
+	b = 0;
+	while (b + 1 < INSTR_BUCKETS)
+	{
+		seen += hist[b];
+		if (seen * 100 >= calls * pct)
+			break ;
+		b++;
+	}
+	return ((size_t)2 << b);
+}
+
+static void	action_line(const t_profile *profile, size_t action)
+{
+	char	line[DIAG_LINE];
+	size_t	len;
+	size_t	calls;
+
+	calls = profile->calls[action];
+	len = diag_cat_sa(line, 0, INSTR_PREFIX);
+	len = diag_cat_sa(line, len, action_name(action));
+	len = diag_cat_sa(line, len, " calls ");
+	len = diag_num_sa(line, len, calls, 10);
+	len = diag_cat_sa(line, len, ", mean ");
+	len = diag_num_sa(line, len, profile->cycles[action] / calls, 10);
+	len = diag_cat_sa(line, len, ", p50 < ");
+	len = diag_num_sa(line, len,
+			percentile(profile->latency[action], calls, 50), 10);
+	len = diag_cat_sa(line, len, ", p99 < ");
+	len = diag_num_sa(line, len,
+			percentile(profile->latency[action], calls, 99), 10);
+	len = diag_cat_sa(line, len, " " INSTR_UNIT "\n");
+	diag_push_sa(line, len);
+}
+
+static void	probe_line(const t_profile *profile, int kind)
+{
+	char	line[DIAG_LINE];
+	size_t	len;
+	size_t	i;
+
+	len = diag_cat_sa(line, 0, INSTR_PREFIX);
+	len = diag_cat_sa(line, len,
+			(const char *[2]){"lookup probes", "place probes"}[kind]);
+	i = 0;
+	while (i < INSTR_PROBES)
+	{
+		if (profile->probes[kind][i])
+		{
+			len = diag_cat_sa(line, len, " ");
+			len = diag_num_sa(line, len, i + 1, 10);
+			if (i + 1 == INSTR_PROBES)
+				len = diag_cat_sa(line, len, "+");
+			len = diag_cat_sa(line, len, ":");
+			len = diag_num_sa(line, len, profile->probes[kind][i], 10);
+		}
+		i++;
+	}
+	diag_push_sa(line, diag_cat_sa(line, len, "\n"));
+}
+
+void	instr_report_sa(const t_profile *profile)
+{
+	size_t	action;
+
+	action = 0;
+	while (action < ACTION_COUNT)
+	{
+		if (profile->calls[action])
+			action_line(profile, action);
+		action++;
+	}
+	probe_line(profile, INSTR_FIND);
+	probe_line(profile, INSTR_PLACE);
+}
@@ -0,0 +1,82 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_leak.c                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 15:44:34 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 18:38:04 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+t_leak	*leak_sa(void)
+{
+	static t_leak	leak = {PTHREAD_MUTEX_INITIALIZER, false, false,
+		LEAK_TEXT, DIAG_FD, false};
+
+	return (&leak);
+}
+
+/*
+** The diagnostics ring registers its exit handler before this one, so it
+** runs after the report and still writes what the report flushes late.
+*/
+void	*leak_action_sa(const size_t *size, const char *path)
+{
+	t_leak	*leak;
+	int		fd;
+
+	leak = leak_sa();
+	fd = out_open_sa(size, path);
+	if (fd < 0)
+		return (diag_msg_sa(ERR_LEAK_TARGET), NULL);
+	diag_sa();
+	fork_handlers_sa();
+	pthread_mutex_lock(&leak->lock);
+	if (leak->owned_fd)
+		close(leak->fd);
+	if (!leak->armed)
+		atexit(leak_report_sa);
+	leak->fd = fd;
+	leak->owned_fd = (path != NULL);
+	leak->format = LEAK_TEXT;
+	if (size && size[1] == LEAK_CSV)
+		leak->format = LEAK_CSV;
+	leak->armed = true;
+	leak->done = false;
+	pthread_mutex_unlock(&leak->lock);
+	return (NULL);
+}
+
+static void	write_report(int fd, int format)
+{
+	t_leak_groups	groups;
+	t_out			out;
+	size_t			n;
+
+	ft_memset_sa(&groups, 0, sizeof(t_leak_groups));
+	leak_collect_sa(&groups);
+	n = leak_sort_sa(&groups);
+	out.fd = fd;
+	out.len = 0;
+	leak_write_sa(&out, &groups, n, format);
+	RAW_FREE(groups.slots);
+}
+
+void	leak_report_sa(void)
+{
+	t_leak	*leak;
+
+	leak = leak_sa();
+	pthread_mutex_lock(&leak->lock);
+	if (leak->armed && !leak->done)
+	{
+		diag_flush_sa();
+		write_report(leak->fd, leak->format);
+		leak->done = true;
+	}
+	pthread_mutex_unlock(&leak->lock);
+}
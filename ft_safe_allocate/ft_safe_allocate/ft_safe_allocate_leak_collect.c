@@ -0,0 +1,95 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_leak_collect.c                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 15:44:34 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 15:53:17 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+static t_leak_group	*find_group(
+	t_leak_group *slots, size_t capacity, size_t size, size_t site)
+{
+	size_t	pos;
+
+	pos = hash_ptr((const void *)(uintptr_t)(size ^ site * 0x9e3779b97f4a7c15))
+		& (capacity - 1);
+	while (slots[pos].count
+		&& (slots[pos].size != size || slots[pos].site != site))
+		pos = (pos + 1) & (capacity - 1);
+	return (&slots[pos]);
+}
+
+/*
+** A table that cannot grow is dropped; capacity stays set so no later
+** block retries, and the report falls back to the totals.
+*/
+static void	grow_groups(t_leak_groups *groups)
+{
+	t_leak_group	*slots;
+	t_leak_group	*old;
+	size_t			capacity;
+	size_t			i;
+
+	capacity = LEAK_GROUPS;
+	if (groups->capacity)
+		capacity = groups->capacity * 2;
+	slots = NULL;
+	if (capacity <= SIZE_MAX / 2 / sizeof(t_leak_group))
+		slots = ft_calloc_sa(capacity, sizeof(t_leak_group));
+	i = 0;
+	while (slots && i < groups->capacity)
+	{
+		old = &groups->slots[i++];
+		if (old->count)
+			*find_group(slots, capacity, old->size, old->site) = *old;
+	}
+	RAW_FREE(groups->slots);
+	groups->slots = slots;
+	groups->capacity = capacity;
+}
+
+static void	add_block(t_allocation *entry, void *arg)
+{
+	t_leak_groups	*groups;
+	t_leak_group	*group;
+
+	groups = arg;
+	groups->blocks++;
+	groups->bytes += entry->size;
+	if ((groups->slots || !groups->capacity)
+		&& (groups->used + 1) * 4 > groups->capacity * 3)
+		grow_groups(groups);
+	if (!groups->slots)
+		return ;
+	group = find_group(groups->slots, groups->capacity,
+			entry->size, site_of_sa(entry));
+	if (!group->count)
+	{
+		group->size = entry->size;
+		group->site = site_of_sa(entry);
+		groups->used++;
+	}
+	group->count++;
+}
+
+/*
+** The magazines stay locked during the tracker walk, as in FREE_ALL, so
+** no block moves between the two while they are read.
+*/
+void	leak_collect_sa(t_leak_groups *groups)
+{
+	if (THREAD_MAGAZINES)
+	{
+		magazine_lock_all_sa();
+		magazine_foreach_sa(add_block, groups);
+	}
+	tracker_foreach_sa(tracker_sa(), add_block, groups);
+	if (THREAD_MAGAZINES)
+		magazine_unlock_all_sa();
+}
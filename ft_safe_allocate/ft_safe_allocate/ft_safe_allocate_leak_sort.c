@@ -0,0 +1,84 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_leak_sort.c                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 15:44:34 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 15:53:17 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+static bool	before(const t_leak_group *a, const t_leak_group *b)
+{
+	if (a->size != b->size)
+		return (a->size > b->size);
+	return (a->count > b->count);
+}
+
+/*
+** Heap whose root is the group that sorts last.
+*/
+static void	sift_down(t_leak_group *groups, size_t n, size_t i)
+{
+	t_leak_group	tmp;
+	size_t			child;
+
+	while (i * 2 + 1 < n)
+	{
+		child = i * 2 + 1;
+		if (child + 1 < n && before(&groups[child], &groups[child + 1]))
+			child++;
+		if (!before(&groups[i], &groups[child]))
+			return ;
+		tmp = groups[i];
+		groups[i] = groups[child];
+		groups[child] = tmp;
+		i = child;
+	}
+}
+
+static size_t	compact(t_leak_group *slots, size_t capacity)
+{
+	size_t	n;
+	size_t	i;
+
+	n = 0;
+	i = 0;
+	while (slots && i < capacity)
+	{
+		if (slots[i].count)
+			slots[n++] = slots[i];
+		i++;
+	}
+	return (n);
+}
+
+/*
+** Heapsort: in place and O(n log n) whatever the number of distinct sizes.
+*/
+size_t	leak_sort_sa(t_leak_groups *groups)
+{
+	t_leak_group	*slots;
+	t_leak_group	tmp;
+	size_t			n;
+	size_t			i;
+
+	slots = groups->slots;
+	n = compact(slots, groups->capacity);
+	i = n / 2;
+	while (i-- > 0)
+		sift_down(slots, n, i);
+	i = n;
+	while (i-- > 1)
+	{
+		tmp = slots[0];
+		slots[0] = slots[i];
+		slots[i] = tmp;
+		sift_down(slots, i, 0);
+	}
+	return (n);
+}
@@ -0,0 +1,74 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_leak_write.c                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 15:44:34 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 16:15:37 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+static void	summary_line(t_out *out, const t_leak_groups *groups)
+{
+	char	line[DIAG_LINE];
+	size_t	len;
+
+	len = diag_cat_sa(line, 0, "Leak report: ");
+	len = diag_num_sa(line, len, groups->blocks, 10);
+	len = diag_cat_sa(line, len, " blocks, ");
+	len = diag_num_sa(line, len, groups->bytes, 10);
+	len = diag_cat_sa(line, len, " bytes still tracked\n");
+	if (groups->blocks && !groups->slots)
+		len = diag_cat_sa(line, len, "  (no memory left to group them)\n");
+	out_line_sa(out, line, len);
+}
+
+/*
+** Separators around size, count, total and caller, in each format.
+*/
+static void	group_line(t_out *out, const t_leak_group *group, int format)
+{
+	static const char	*sep[2][5] = {
+	{"  ", " bytes x ", " = ", " bytes from 0x", " bytes"},
+	{"", ",", ",", ",0x", ","}};
+	char				line[DIAG_LINE];
+	size_t				len;
+	void				*caller;
+
+	caller = NULL;
+	if (ALLOC_SITES)
+		caller = atomic_load(&sites_sa()->slots[group->site].caller);
+	len = diag_num_sa(line, diag_cat_sa(line, 0, sep[format][0]),
+			group->size, 10);
+	len = diag_num_sa(line, diag_cat_sa(line, len, sep[format][1]),
+			group->count, 10);
+	len = diag_num_sa(line, diag_cat_sa(line, len, sep[format][2]),
+			group->size * group->count, 10);
+	if (caller)
+		len = diag_num_sa(line, diag_cat_sa(line, len, sep[format][3]),
+				(uintptr_t)caller, 16);
+	else
+		len = diag_cat_sa(line, len, sep[format][4]);
+	out_line_sa(out, line, diag_cat_sa(line, len, "\n"));
+}
+
+void	leak_write_sa(
+	t_out *out, const t_leak_groups *groups, size_t n, int format)
+{
+	char	line[DIAG_LINE];
+	size_t	i;
+
+	if (format == LEAK_CSV)
+		out_line_sa(out, line,
+			diag_cat_sa(line, 0, "size,count,bytes,caller\n"));
+	else
+		summary_line(out, groups);
+	i = 0;
+	while (i < n)
+		group_line(out, &groups->slots[i++], format);
+	out_flush_sa(out);
+}
@@ -0,0 +1,124 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_lockfree.c                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 12:50:34 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 18:00:12 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+#if LOCK_FREE_TRACKING
+
+static int	claim_free_slot(t_lf_slot *slot, const void *ptr)
+{
+	void	*key;
+
+	key = atomic_load_explicit(&slot->key, memory_order_acquire);
+	while (key == NULL || key == SLOT_TOMBSTONE)
+	{
+		if (atomic_compare_exchange_weak_explicit(&slot->key, &key,
+				(void *)((uintptr_t)ptr | SLOT_BUSY_BIT),
+				memory_order_acquire, memory_order_acquire))
+			return (SUCCESS);
+	}
+	return (ERROR);
+}
+
+/*
+** max_probe is raised before the key is published, so whoever gets the
+** pointer back finds it. Past LOCKFREE_MAX_PROBE the block spills.
+*/
+int	tracker_insert_sa(t_tracker *tracker, const t_allocation *entry)
+{
+	size_t		hash;
+	size_t		i;
+	t_lf_slot	*slot;
+
+	hash = hash_ptr(entry->user_ptr);
+	i = 0;
+	while (i < LOCKFREE_MAX_PROBE && i < LOCKFREE_TABLE_SIZE)
+	{
+		slot = &tracker->slots[(hash + i++) & (LOCKFREE_TABLE_SIZE - 1)];
+		if (claim_free_slot(slot, entry->user_ptr) == SUCCESS)
+		{
+			slot->entry = *entry;
+			header_set_slot_sa(entry, slot - tracker->slots);
+			lf_note_probe_sa(tracker, i);
+			atomic_store_explicit(
+				&slot->key, entry->user_ptr, memory_order_release);
+			if (INSTRUMENT)
+				instr_probe_sa(INSTR_PLACE, i);
+			atomic_fetch_add(&tracker->live, 1);
+			return (SUCCESS);
+		}
+	}
+	return (lf_spill_insert_sa(tracker, entry));
+}
+
+static int	claim_key(t_lf_slot *slot, const void *ptr)
+{
+	void	*key;
+	void	*busy;
+
+	busy = (void *)((uintptr_t)ptr | SLOT_BUSY_BIT);
+	key = atomic_load_explicit(&slot->key, memory_order_acquire);
+	while (key == ptr || key == busy)
+	{
+		if (key == busy)
+		{
+			sched_yield();
+			key = atomic_load_explicit(&slot->key, memory_order_acquire);
+		}
+		else if (atomic_compare_exchange_weak_explicit(&slot->key, &key,
+				busy, memory_order_acquire, memory_order_acquire))
+			return (SUCCESS);
+	}
+	return (ERROR);
+}
+
+static t_lf_slot	*claim_hint(t_tracker *tracker, const void *ptr)
+{
+	size_t	hint;
+
+	if (!INLINE_HEADER)
+		return (NULL);
+	hint = header_slot_sa(ptr);
+	if (hint < LOCKFREE_TABLE_SIZE
+		&& claim_key(&tracker->slots[hint], ptr) == SUCCESS)
+		return (&tracker->slots[hint]);
+	return (NULL);
+}
+
+t_lf_slot	*lf_claim_sa(t_tracker *tracker, const void *ptr)
+{
+	size_t		hash;
+	size_t		i;
+	t_lf_slot	*slot;
+	t_lf_slot	*found;
+	size_t		bound;
+
+	if (!ptr || ptr == SLOT_TOMBSTONE)
+		return (NULL);
+	found = claim_hint(tracker, ptr);
+	hash = hash_ptr(ptr);
+	bound = atomic_load_explicit(&tracker->max_probe, memory_order_acquire);
+	i = 0;
+	while (!found && i < bound)
+	{
+		slot = &tracker->slots[(hash + i++) & (LOCKFREE_TABLE_SIZE - 1)];
+		if (atomic_load_explicit(&slot->key, memory_order_acquire) == NULL)
+			break ;
+		if (claim_key(slot, ptr) == SUCCESS)
+			found = slot;
+	}
+	if (INSTRUMENT)
+		instr_probe_sa(INSTR_FIND, i);
+	return (found);
+}
+
+#endif
@@ -0,0 +1,67 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_lockfree_batch.c                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 14:05:42 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 18:38:04 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+#if LOCK_FREE_TRACKING
+
+void	lf_note_probe_sa(t_tracker *tracker, size_t probes)
+{
+	size_t	seen;
+
+	seen = atomic_load_explicit(&tracker->max_probe, memory_order_relaxed);
+	while (seen < probes && !atomic_compare_exchange_weak_explicit(
+			&tracker->max_probe, &seen, probes,
+			memory_order_release, memory_order_relaxed))
+		;
+}
+
+int	tracker_insert_batch_sa(
+	t_tracker *tracker, const t_allocation *entries, size_t n)
+{
+	size_t	i;
+
+	i = 0;
+	while (i < n)
+	{
+		if (tracker_insert_sa(tracker, &entries[i]) == ERROR)
+			return (ERROR);
+		i++;
+	}
+	return (SUCCESS);
+}
+
+size_t	tracker_remove_batch_sa(
+	t_tracker *tracker, t_allocation *entries, size_t n)
+{
+	size_t	removed;
+	size_t	i;
+
+	removed = 0;
+	i = 0;
+	while (i < n)
+	{
+		if (untrack_sa(tracker, entries[i].user_ptr, &entries[i]) == SUCCESS)
+			removed++;
+		else
+			entries[i].user_ptr = NULL;
+		i++;
+	}
+	return (removed);
+}
+
+void	tracker_locks_sa(t_tracker *tracker, int (*op)(pthread_mutex_t *))
+{
+	op(&tracker->overflow.lock);
+}
+
+#endif
@@ -0,0 +1,100 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_lockfree_ops.c                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 12:50:34 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 18:00:12 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+#if LOCK_FREE_TRACKING
+
+t_tracker	*tracker_sa(void)
+{
+	static t_tracker	tracker = {.overflow.lock = PTHREAD_MUTEX_INITIALIZER};
+
+	return (&tracker);
+}
+
+int	untrack_sa(t_tracker *tracker, const void *ptr, t_allocation *entry)
+{
+	t_lf_slot	*slot;
+
+	slot = lf_claim_sa(tracker, ptr);
+	if (!slot)
+		return (lf_spill_remove_sa(tracker, ptr, entry));
+	*entry = slot->entry;
+	atomic_store_explicit(&slot->key, SLOT_TOMBSTONE, memory_order_release);
+	atomic_fetch_sub(&tracker->live, 1);
+	return (SUCCESS);
+}
+
+int	lf_claim_live_sa(t_lf_slot *slot)
+{
+	void	*key;
+
+	key = atomic_load_explicit(&slot->key, memory_order_acquire);
+	if (key == NULL || key == SLOT_TOMBSTONE
+		|| ((uintptr_t)key & SLOT_BUSY_BIT))
+		return (ERROR);
+	if (!atomic_compare_exchange_strong_explicit(&slot->key, &key,
+			(void *)((uintptr_t)key | SLOT_BUSY_BIT),
+			memory_order_acquire, memory_order_relaxed))
+		return (ERROR);
+	return (SUCCESS);
+}
+
+void	tracker_drain_sa(
+	t_tracker *tracker, void (*fn)(t_allocation *, void *), void *arg)
+{
+	t_allocation	entry;
+	size_t			i;
+
+	i = 0;
+	while (i < LOCKFREE_TABLE_SIZE)
+	{
+		if (lf_claim_live_sa(&tracker->slots[i]) == SUCCESS)
+		{
+			entry = tracker->slots[i].entry;
+			atomic_store_explicit(&tracker->slots[i].key,
+				SLOT_TOMBSTONE, memory_order_release);
+			atomic_fetch_sub(&tracker->live, 1);
+			fn(&entry, arg);
+		}
+		i++;
+	}
+	lf_spill_walk_sa(tracker, fn, arg, true);
+}
+
+void	tracker_foreach_sa(
+	t_tracker *tracker, void (*fn)(t_allocation *, void *), void *arg)
+{
+	t_allocation	entry;
+	void			*key;
+	size_t			i;
+
+	i = 0;
+	while (i < LOCKFREE_TABLE_SIZE)
+	{
+		key = atomic_load_explicit(
+				&tracker->slots[i].key, memory_order_acquire);
+		if (key != NULL && key != SLOT_TOMBSTONE
+			&& !((uintptr_t)key & SLOT_BUSY_BIT))
+		{
+			entry = tracker->slots[i].entry;
+			atomic_thread_fence(memory_order_acquire);
+			if (atomic_load_explicit(&tracker->slots[i].key,
+					memory_order_relaxed) == key)
+				fn(&entry, arg);
+		}
+		i++;
+	}
+	lf_spill_walk_sa(tracker, fn, arg, false);
+}
+
+#endif
@@ -0,0 +1,101 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_lockfree_spill.c                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 19:12:05 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 18:38:04 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+#if LOCK_FREE_TRACKING
+
+static t_table	*lock_overflow(t_tracker *tracker)
+{
+	fork_handlers_sa();
+	if (!INSTRUMENT)
+		pthread_mutex_lock(&tracker->overflow.lock);
+	else
+		instr_lock_sa(&tracker->overflow.lock);
+	return (&tracker->overflow.table);
+}
+
+int	lf_spill_insert_sa(t_tracker *tracker, const t_allocation *entry)
+{
+	int	status;
+
+	status = table_insert_sa(lock_overflow(tracker), entry);
+	if (status == SUCCESS)
+		atomic_fetch_add(&tracker->spilled, 1);
+	pthread_mutex_unlock(&tracker->overflow.lock);
+	if (status == SUCCESS && !atomic_exchange(&tracker->warned, true))
+		diag_msg_sa(WARN_LOCKFREE_SPILL);
+	return (status);
+}
+
+int	lf_spill_remove_sa(
+	t_tracker *tracker, const void *ptr, t_allocation *entry)
+{
+	t_table			*table;
+	t_allocation	*slot;
+
+	if (atomic_load(&tracker->spilled) == 0)
+		return (ERROR);
+	table = lock_overflow(tracker);
+	slot = table_find_sa(table, ptr);
+	if (slot)
+	{
+		*entry = *slot;
+		table_remove_sa(table, slot);
+		atomic_fetch_sub(&tracker->spilled, 1);
+	}
+	pthread_mutex_unlock(&tracker->overflow.lock);
+	if (!slot)
+		return (ERROR);
+	return (SUCCESS);
+}
+
+int	lf_spill_update_sa(t_tracker *tracker, const void *ptr,
+	void (*fn)(t_allocation *, void *), void *arg)
+{
+	t_table			*table;
+	t_allocation	*slot;
+
+	if (atomic_load(&tracker->spilled) == 0)
+		return (ERROR);
+	table = lock_overflow(tracker);
+	slot = table_find_sa(table, ptr);
+	if (slot)
+		fn(slot, arg);
+	pthread_mutex_unlock(&tracker->overflow.lock);
+	if (!slot)
+		return (ERROR);
+	return (SUCCESS);
+}
+
+void	lf_spill_walk_sa(t_tracker *tracker,
+	void (*fn)(t_allocation *, void *), void *arg, bool drain)
+{
+	t_table	table;
+
+	if (atomic_load(&tracker->spilled) == 0)
+		return ;
+	if (!drain)
+	{
+		table_foreach_sa(lock_overflow(tracker), fn, arg);
+		pthread_mutex_unlock(&tracker->overflow.lock);
+		return ;
+	}
+	table = *lock_overflow(tracker);
+	ft_memset_sa(&tracker->overflow.table, 0, sizeof(t_table));
+	atomic_store(&tracker->spilled, 0);
+	pthread_mutex_unlock(&tracker->overflow.lock);
+	table_foreach_sa(&table, fn, arg);
+	table_release_sa(&table);
+}
+
+#endif
@@ -0,0 +1,64 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_magazine.c                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 13:06:26 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 19:21:04 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+/*
+** Initial-exec, like the preload depth, so the per-call lookup is a load
+** at a fixed offset from the thread pointer.
+*/
+t_magazine	**magazine_own_sa(void)
+{
+	static _Thread_local t_magazine	*own
+		__attribute__((tls_model("initial-exec")));
+
+	return (&own);
+}
+
+static t_registry	*registry_storage(void)
+{
+	static t_registry	registry = {PTHREAD_MUTEX_INITIALIZER, 0, NULL};
+
+	return (&registry);
+}
+
+/*
+** The magazine stays in the registry for the next new thread; entries a
+** failed merge left behind are still found by the other threads' walk.
+*/
+static void	destroy_magazine(void *arg)
+{
+	t_magazine	*magazine;
+
+	magazine = arg;
+	pthread_mutex_lock(&magazine->lock);
+	magazine_flush_sa(tracker_sa(), magazine, !magazine->young);
+	magazine_flush_sa(tracker_sa(), magazine, magazine->young);
+	pthread_mutex_unlock(&magazine->lock);
+	magazine_purge_sa(magazine);
+	*magazine_own_sa() = NULL;
+	atomic_store_explicit(&magazine->owned, false, memory_order_release);
+}
+
+static void	make_key(void)
+{
+	pthread_key_create(&registry_storage()->key, destroy_magazine);
+	fork_handlers_sa();
+}
+
+t_registry	*registry_sa(void)
+{
+	static pthread_once_t	once = PTHREAD_ONCE_INIT;
+
+	pthread_once(&once, make_key);
+	return (registry_storage());
+}
@@ -0,0 +1,94 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_magazine_flush.c                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 19:31:40 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 19:21:04 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+static void	keep(t_allocation *entry, void *arg)
+{
+	(void)entry;
+	(void)arg;
+}
+
+/*
+** A failed batch may have merged some shards before running out of room,
+** so only the entries the tracker still lacks stay pending.
+*/
+static void	keep_untracked(t_tracker *tracker, t_lf_slot **merged, size_t n)
+{
+	size_t	i;
+
+	i = 0;
+	while (i < n)
+	{
+		if (tracker_update_sa(tracker, merged[i]->entry.user_ptr, keep, NULL)
+			== SUCCESS)
+			atomic_store_explicit(&merged[i]->key, SLOT_TOMBSTONE,
+				memory_order_release);
+		i++;
+	}
+}
+
+static void	clear_half(t_magazine *magazine, int half)
+{
+	size_t	i;
+
+	i = 0;
+	while (i < MAGAZINE_SIZE)
+		atomic_store_explicit(&magazine->slots[half][i++].key, NULL,
+			memory_order_relaxed);
+	ft_memset_sa(magazine->filter[half], 0, sizeof(magazine->filter[half]));
+	magazine->used[half] = 0;
+}
+
+/*
+** Only the owner edits its slots without the lock, and it is the one
+** merging, so the live keys cannot change while the batch is built.
+** Blocks that outlive three quarters of a half gain nothing from the
+** magazine, only the extra copy, so the next allocations skip it.
+*/
+int	magazine_flush_sa(t_tracker *tracker, t_magazine *magazine, int half)
+{
+	t_allocation	batch[MAGAZINE_SIZE / 2];
+	t_lf_slot		*merged[MAGAZINE_SIZE / 2];
+	void			*key;
+	size_t			n;
+	size_t			i;
+
+	n = 0;
+	i = 0;
+	while (i < MAGAZINE_SIZE && n < MAGAZINE_SIZE / 2)
+	{
+		merged[n] = &magazine->slots[half][i++];
+		key = atomic_load_explicit(&merged[n]->key, memory_order_acquire);
+		if (key != NULL && key != SLOT_TOMBSTONE)
+		{
+			batch[n] = merged[n]->entry;
+			n++;
+		}
+	}
+	if (tracker_insert_batch_sa(tracker, batch, n) == ERROR)
+		return (keep_untracked(tracker, merged, n), ERROR);
+	if (n * 8 > MAGAZINE_SIZE * 3)
+		magazine->bypass = MAGAZINE_SIZE * 16;
+	clear_half(magazine, half);
+	return (SUCCESS);
+}
+
+void	magazine_purge_sa(t_magazine *magazine)
+{
+	while (magazine->ncache > 0)
+	{
+		magazine->ncache--;
+		block_free_sa(magazine->cache[magazine->ncache].original_ptr,
+			magazine->cache[magazine->ncache].size);
+	}
+}
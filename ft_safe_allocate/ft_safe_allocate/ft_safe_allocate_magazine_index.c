@@ -0,0 +1,133 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_magazine_index.c                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 18:05:35 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 19:43:36 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+/*
+** A half takes at most MAGAZINE_SIZE / 2 entries in MAGAZINE_SIZE slots,
+** and removed entries leave a tombstone until the half is merged, so a
+** probe always ends on an empty slot.
+*/
+t_lf_slot	*magazine_find_sa(t_magazine *magazine, const void *ptr)
+{
+	t_lf_slot	*slot;
+	uintptr_t	key;
+	size_t		hash;
+	size_t		i;
+	int			half;
+
+	hash = hash_ptr(ptr);
+	half = 0;
+	while (half < 2)
+	{
+		i = 0;
+		while (i < MAGAZINE_SIZE)
+		{
+			slot = &magazine->slots[half][(hash + i++) & (MAGAZINE_SIZE - 1)];
+			key = (uintptr_t)atomic_load_explicit(&slot->key,
+					memory_order_acquire);
+			if (key == 0)
+				break ;
+			if ((key & ~(uintptr_t)SLOT_BUSY_BIT) == (uintptr_t)ptr)
+				return (slot);
+		}
+		half++;
+	}
+	return (NULL);
+}
+
+/*
+** The owner and another thread after the same pointer race on one
+** compare-and-swap, so exactly one of them gets the entry.
+*/
+t_lf_slot	*magazine_claim_sa(t_magazine *magazine, const void *ptr)
+{
+	t_lf_slot	*slot;
+	void		*key;
+	void		*busy;
+
+	slot = magazine_find_sa(magazine, ptr);
+	if (!slot)
+		return (NULL);
+	busy = (void *)((uintptr_t)ptr | SLOT_BUSY_BIT);
+	key = atomic_load_explicit(&slot->key, memory_order_acquire);
+	while (key == ptr || key == busy)
+	{
+		if (key == busy)
+		{
+			sched_yield();
+			key = atomic_load_explicit(&slot->key, memory_order_acquire);
+		}
+		else if (atomic_compare_exchange_weak_explicit(&slot->key, &key,
+				busy, memory_order_acquire, memory_order_acquire))
+			return (slot);
+	}
+	return (NULL);
+}
+
+int	magazine_take_sa(
+	t_magazine *magazine, const void *ptr, t_allocation *entry)
+{
+	t_lf_slot	*slot;
+
+	slot = magazine_claim_sa(magazine, ptr);
+	if (!slot)
+		return (ERROR);
+	*entry = slot->entry;
+	atomic_store_explicit(&slot->key, SLOT_TOMBSTONE, memory_order_release);
+	return (SUCCESS);
+}
+
+/*
+** The filter has eight bits per slot and takes two of them per pointer,
+** from the hash bits above the slot index, so a pointer that left the
+** magazine passes it about one time in twenty.
+*/
+bool	magazine_may_hold_sa(t_magazine *magazine, const void *ptr)
+{
+	size_t	hash;
+	size_t	a;
+	size_t	b;
+
+	hash = hash_ptr(ptr) / MAGAZINE_SIZE;
+	a = hash % (MAGAZINE_SIZE * 8);
+	b = hash / (MAGAZINE_SIZE * 8) % (MAGAZINE_SIZE * 8);
+	return ((((magazine->filter[0][a / 64] | magazine->filter[1][a / 64])
+			>> (a % 64)) & ((magazine->filter[0][b / 64]
+				| magazine->filter[1][b / 64]) >> (b % 64)) & 1) != 0);
+}
+
+void	magazine_place_sa(t_magazine *magazine, const t_allocation *entry)
+{
+	t_lf_slot	*slot;
+	void		*key;
+	size_t		hash;
+	size_t		bit;
+	int			young;
+
+	young = magazine->young;
+	hash = hash_ptr(entry->user_ptr);
+	bit = hash / MAGAZINE_SIZE % (MAGAZINE_SIZE * 8);
+	magazine->filter[young][bit / 64] |= (uint64_t)1 << (bit % 64);
+	bit = hash / MAGAZINE_SIZE / (MAGAZINE_SIZE * 8) % (MAGAZINE_SIZE * 8);
+	magazine->filter[young][bit / 64] |= (uint64_t)1 << (bit % 64);
+	while (true)
+	{
+		slot = &magazine->slots[young][hash++ & (MAGAZINE_SIZE - 1)];
+		key = atomic_load_explicit(&slot->key, memory_order_acquire);
+		if (key == NULL || key == SLOT_TOMBSTONE)
+			break ;
+	}
+	slot->entry = *entry;
+	atomic_store_explicit(&slot->key, entry->user_ptr, memory_order_release);
+	magazine->used[young]++;
+}
@@ -0,0 +1,144 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_magazine_ops.c                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 13:06:26 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 19:21:04 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+/*
+** New entries go to the young half. When it is full, the old half is
+** merged into the tracker and the halves swap, so every entry stays local
+** for at least MAGAZINE_SIZE / 2 allocations of its thread. If the merge
+** fails both halves stay full, and the entry goes straight to the tracker,
+** as it does while the magazine is bypassed.
+*/
+int	magazine_insert_sa(t_tracker *tracker, const t_allocation *entry)
+{
+	t_magazine	*magazine;
+	int			status;
+
+	magazine = magazine_sa();
+	if (!magazine || magazine->bypass > 0)
+	{
+		if (magazine)
+			magazine->bypass--;
+		return (tracker_insert_sa(tracker, entry));
+	}
+	if (magazine->used[magazine->young] == MAGAZINE_SIZE / 2)
+	{
+		pthread_mutex_lock(&magazine->lock);
+		status = magazine_flush_sa(tracker, magazine, !magazine->young);
+		pthread_mutex_unlock(&magazine->lock);
+		if (status == ERROR)
+			return (tracker_insert_sa(tracker, entry));
+		magazine->young = !magazine->young;
+	}
+	magazine_place_sa(magazine, entry);
+	return (SUCCESS);
+}
+
+/*
+** The unlocked probe only picks the magazine to lock, so the walk never
+** waits on a thread that does not hold ptr.
+*/
+static int	take_from_others(
+	t_magazine *self, const void *ptr, t_allocation *entry)
+{
+	t_magazine	*magazine;
+	int			status;
+
+	status = ERROR;
+	magazine = atomic_load_explicit(&registry_sa()->head,
+			memory_order_acquire);
+	while (magazine && status == ERROR)
+	{
+		if (magazine != self && magazine_find_sa(magazine, ptr))
+		{
+			pthread_mutex_lock(&magazine->lock);
+			status = magazine_take_sa(magazine, ptr, entry);
+			pthread_mutex_unlock(&magazine->lock);
+		}
+		magazine = magazine->next;
+	}
+	return (status);
+}
+
+/*
+** Own magazine first, then the shared table, then the other threads'
+** magazines. Entries only ever move from a magazine to the table, so the
+** table is checked once more after the walk to catch a concurrent flush.
+*/
+int	magazine_remove_sa(
+	t_tracker *tracker, const void *ptr, t_allocation *entry)
+{
+	t_magazine	*magazine;
+	int			status;
+
+	magazine = magazine_sa();
+	status = ERROR;
+	if (magazine && magazine_may_hold_sa(magazine, ptr))
+		status = magazine_take_sa(magazine, ptr, entry);
+	if (status == ERROR)
+		status = untrack_sa(tracker, ptr, entry);
+	if (status == ERROR)
+		status = take_from_others(magazine, ptr, entry);
+	if (status == ERROR)
+		status = untrack_sa(tracker, ptr, entry);
+	return (status);
+}
+
+/*
+** owned is only ever raised here, under the registry lock, so a magazine
+** released by an exiting thread goes to exactly one new thread.
+*/
+static t_magazine	*enlist(t_registry *registry)
+{
+	t_magazine	*magazine;
+
+	magazine = atomic_load_explicit(&registry->head, memory_order_acquire);
+	while (magazine)
+	{
+		if (!atomic_load_explicit(&magazine->owned, memory_order_acquire))
+		{
+			atomic_store_explicit(&magazine->owned, true,
+				memory_order_relaxed);
+			return (magazine);
+		}
+		magazine = magazine->next;
+	}
+	magazine = ft_calloc_sa(1, sizeof(t_magazine));
+	if (!magazine)
+		return (NULL);
+	pthread_mutex_init(&magazine->lock, NULL);
+	atomic_init(&magazine->owned, true);
+	magazine->next = atomic_load_explicit(&registry->head,
+			memory_order_relaxed);
+	atomic_store_explicit(&registry->head, magazine, memory_order_release);
+	return (magazine);
+}
+
+t_magazine	*magazine_sa(void)
+{
+	t_registry	*registry;
+	t_magazine	*magazine;
+
+	magazine = *magazine_own_sa();
+	if (magazine)
+		return (magazine);
+	registry = registry_sa();
+	pthread_mutex_lock(&registry->lock);
+	magazine = enlist(registry);
+	pthread_mutex_unlock(&registry->lock);
+	if (!magazine)
+		return (NULL);
+	pthread_setspecific(registry->key, magazine);
+	*magazine_own_sa() = magazine;
+	return (magazine);
+}
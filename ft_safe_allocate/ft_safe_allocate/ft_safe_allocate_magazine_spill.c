@@ -0,0 +1,70 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_magazine_spill.c                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 19:26:56 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 19:43:36 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+static bool	spill_from(t_tracker *tracker, t_magazine *magazine,
+	const void *ptr, int *status)
+{
+	t_lf_slot	*slot;
+
+	slot = magazine_claim_sa(magazine, ptr);
+	if (!slot)
+		return (false);
+	*status = tracker_insert_sa(tracker, &slot->entry);
+	if (*status == SUCCESS)
+		atomic_store_explicit(&slot->key, SLOT_TOMBSTONE,
+			memory_order_release);
+	else
+		atomic_store_explicit(&slot->key, (void *)ptr, memory_order_release);
+	return (true);
+}
+
+static int	spill_from_others(
+	t_tracker *tracker, t_magazine *own, const void *ptr)
+{
+	t_magazine	*magazine;
+	int			status;
+	bool		found;
+
+	status = ERROR;
+	found = false;
+	magazine = atomic_load_explicit(&registry_sa()->head,
+			memory_order_acquire);
+	while (magazine && !found)
+	{
+		if (magazine != own && magazine_find_sa(magazine, ptr))
+		{
+			pthread_mutex_lock(&magazine->lock);
+			found = spill_from(tracker, magazine, ptr, &status);
+			pthread_mutex_unlock(&magazine->lock);
+		}
+		magazine = magazine->next;
+	}
+	return (status);
+}
+
+/*
+** Same walk as magazine_remove_sa(): own magazine without the lock, then
+** an unlocked probe of the others and the lock of the one holding ptr.
+*/
+int	magazine_spill_sa(t_tracker *tracker, const void *ptr)
+{
+	t_magazine	*own;
+	int			status;
+
+	own = *magazine_own_sa();
+	if (own && magazine_may_hold_sa(own, ptr)
+		&& spill_from(tracker, own, ptr, &status))
+		return (status);
+	return (spill_from_others(tracker, own, ptr));
+}
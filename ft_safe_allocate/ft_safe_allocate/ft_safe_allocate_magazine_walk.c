@@ -0,0 +1,122 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_magazine_walk.c                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 13:06:26 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 19:21:04 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+void	magazine_lock_all_sa(void)
+{
+	t_registry	*registry;
+	t_magazine	*magazine;
+
+	registry = registry_sa();
+	pthread_mutex_lock(&registry->lock);
+	magazine = atomic_load_explicit(&registry->head, memory_order_acquire);
+	while (magazine)
+	{
+		pthread_mutex_lock(&magazine->lock);
+		magazine = magazine->next;
+	}
+}
+
+void	magazine_unlock_all_sa(void)
+{
+	t_registry	*registry;
+	t_magazine	*magazine;
+
+	registry = registry_sa();
+	magazine = atomic_load_explicit(&registry->head, memory_order_acquire);
+	while (magazine)
+	{
+		pthread_mutex_unlock(&magazine->lock);
+		magazine = magazine->next;
+	}
+	pthread_mutex_unlock(&registry->lock);
+}
+
+/*
+** A busy slot is being freed by its owner, or was left that way by a
+** thread that did not survive fork(), so it is skipped rather than waited
+** on. Returns the key the slot held, or NULL if it was not claimed.
+*/
+static void	*claim_live(t_lf_slot *slot)
+{
+	void	*key;
+
+	key = atomic_load_explicit(&slot->key, memory_order_acquire);
+	if (key == NULL || key == SLOT_TOMBSTONE
+		|| ((uintptr_t)key & SLOT_BUSY_BIT))
+		return (NULL);
+	if (!atomic_compare_exchange_strong_explicit(&slot->key, &key,
+			(void *)((uintptr_t)key | SLOT_BUSY_BIT),
+			memory_order_acquire, memory_order_relaxed))
+		return (NULL);
+	return (key);
+}
+
+void	magazine_foreach_sa(void (*fn)(t_allocation *, void *), void *arg)
+{
+	t_magazine	*magazine;
+	t_lf_slot	*slot;
+	void		*key;
+	size_t		i;
+
+	magazine = atomic_load_explicit(&registry_sa()->head,
+			memory_order_acquire);
+	while (magazine)
+	{
+		i = 0;
+		while (i < 2 * MAGAZINE_SIZE)
+		{
+			slot = &magazine->slots[i / MAGAZINE_SIZE][i % MAGAZINE_SIZE];
+			key = claim_live(slot);
+			if (key)
+			{
+				fn(&slot->entry, arg);
+				atomic_store_explicit(&slot->key, key, memory_order_release);
+			}
+			i++;
+		}
+		magazine = magazine->next;
+	}
+}
+
+/*
+** The entry is copied before the tombstone goes in: from then on the
+** owner may reuse the slot.
+*/
+void	magazine_drain_sa(void (*fn)(t_allocation *, void *), void *arg)
+{
+	t_magazine		*magazine;
+	t_allocation	entry;
+	t_lf_slot		*slot;
+	size_t			i;
+
+	magazine = atomic_load_explicit(&registry_sa()->head,
+			memory_order_acquire);
+	while (magazine)
+	{
+		i = 0;
+		while (i < 2 * MAGAZINE_SIZE)
+		{
+			slot = &magazine->slots[i / MAGAZINE_SIZE][i % MAGAZINE_SIZE];
+			if (claim_live(slot))
+			{
+				entry = slot->entry;
+				atomic_store_explicit(&slot->key, SLOT_TOMBSTONE,
+					memory_order_release);
+				fn(&entry, arg);
+			}
+			i++;
+		}
+		magazine = magazine->next;
+	}
+}
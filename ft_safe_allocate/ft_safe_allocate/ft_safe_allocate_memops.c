@@ -0,0 +1,50 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_memops.c                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 13:55:23 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 13:55:23 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+static t_memops	*memops_storage(void)
+{
+	static t_memops	memops = {word_memset_sa, word_memcpy_sa, "scalar"};
+
+	return (&memops);
+}
+
+#if SIMD_MEMOPS
+
+static void	select_memops(void)
+{
+	t_memops	*memops;
+
+	memops = memops_storage();
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2"))
+		*memops = (t_memops){avx2_memset_sa, avx2_memcpy_sa, "avx2"};
+	else if (__builtin_cpu_supports("sse2"))
+		*memops = (t_memops){sse2_memset_sa, sse2_memcpy_sa, "sse2"};
+}
+
+#else
+
+static void	select_memops(void)
+{
+}
+
+#endif
+
+const t_memops	*memops_sa(void)
+{
+	static pthread_once_t	once = PTHREAD_ONCE_INIT;
+
+	pthread_once(&once, select_memops);
+	return (memops_storage());
+}
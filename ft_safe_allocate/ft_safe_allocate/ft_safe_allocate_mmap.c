@@ -0,0 +1,69 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_mmap.c                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 13:58:45 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 13:58:45 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#define _GNU_SOURCE
+#include "../include/ft_safe_allocate.h"
+
+size_t	mapped_size_sa(size_t total)
+{
+	size_t	page;
+
+	page = (size_t)sysconf(_SC_PAGESIZE);
+	return ((total + page - 1) / page * page);
+}
+
+/*
+** Fresh anonymous pages read as zero and are only backed by memory once
+** written, so large blocks need no memset.
+*/
+void	*mmap_block_sa(size_t total)
+{
+	void	*block;
+
+	block = mmap(NULL, mapped_size_sa(total), PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (block == MAP_FAILED)
+		return (NULL);
+	return (block);
+}
+
+void	munmap_block_sa(void *block, size_t total)
+{
+	munmap(block, mapped_size_sa(total));
+}
+
+#ifdef MREMAP_MAYMOVE
+
+void	*remap_block_sa(void *block, size_t old_total, size_t new_total)
+{
+	void	*moved;
+
+	if (old_total < MMAP_MIN_BLOCK || new_total < MMAP_MIN_BLOCK)
+		return (NULL);
+	moved = mremap(block, mapped_size_sa(old_total),
+			mapped_size_sa(new_total), MREMAP_MAYMOVE);
+	if (moved == MAP_FAILED)
+		return (NULL);
+	return (moved);
+}
+
+#else
+
+void	*remap_block_sa(void *block, size_t old_total, size_t new_total)
+{
+	if (old_total < MMAP_MIN_BLOCK || new_total < MMAP_MIN_BLOCK
+		|| mapped_size_sa(old_total) != mapped_size_sa(new_total))
+		return (NULL);
+	return (block);
+}
+
+#endif
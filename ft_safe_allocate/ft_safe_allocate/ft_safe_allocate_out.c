@@ -0,0 +1,46 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_out.c                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 15:55:09 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 15:55:09 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+int	out_open_sa(const size_t *size, const char *path)
+{
+	if (path)
+		return (open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644));
+	if (size)
+		return ((int)size[0]);
+	return (DIAG_FD);
+}
+
+void	out_flush_sa(t_out *out)
+{
+	ssize_t	done;
+	size_t	sent;
+
+	sent = 0;
+	while (sent < out->len)
+	{
+		done = write(out->fd, out->buf + sent, out->len - sent);
+		if (done <= 0)
+			break ;
+		sent += done;
+	}
+	out->len = 0;
+}
+
+void	out_line_sa(t_out *out, const char *line, size_t len)
+{
+	if (out->len + len > OUT_BUFFER)
+		out_flush_sa(out);
+	ft_memcpy_sa(out->buf + out->len, line, len);
+	out->len += len;
+}
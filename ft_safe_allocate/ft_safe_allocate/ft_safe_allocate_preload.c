@@ -0,0 +1,67 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_preload.c                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 18:02:44 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 18:02:44 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+/*
+** Initial-exec TLS is a fixed offset from the thread pointer: reading it
+** never calls __tls_get_addr(), which may itself allocate.
+*/
+static int	*preload_depth(void)
+{
+	static _Thread_local int	depth
+		__attribute__((tls_model("initial-exec")));
+
+	return (&depth);
+}
+
+bool	preload_enter_sa(void)
+{
+	return ((*preload_depth())++ == 0);
+}
+
+void	preload_leave_sa(void)
+{
+	(*preload_depth())--;
+}
+
+/*
+** Like allocate_ptr(), but a failure is reported through errno instead of
+** ending the program.
+*/
+void	*preload_alloc_sa(size_t bytes, size_t align, bool zero)
+{
+	t_allocation	entry;
+
+	if (new_block_sa(&entry, bytes, align, zero) == ERROR)
+		return (errno = ENOMEM, NULL);
+	if (HEAP_PROFILE)
+		sample_take_sa(&entry);
+	if (track_sa(tracker_sa(), &entry) == SUCCESS)
+		return (entry.user_ptr);
+	if (HEAP_PROFILE)
+		sample_release_sa(&entry);
+	block_free_sa(entry.original_ptr, block_total_sa(&entry));
+	return (errno = ENOMEM, NULL);
+}
+
+int	preload_release_sa(void *ptr)
+{
+	t_allocation	entry;
+
+	if (forget_sa(tracker_sa(), ptr, &entry) == ERROR)
+		return (ERROR);
+	if (MEMORY_FENCING && !page_guarded_sa(block_total_sa(&entry)))
+		check_memfen(entry.user_ptr, entry.size);
+	release_block_sa(&entry);
+	return (SUCCESS);
+}
@@ -0,0 +1,99 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_preload_api.c                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 18:02:44 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 19:53:32 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+/*
+** Only built into the preload object. Every entry point falls back to
+** glibc when the thread is already inside the tracker, or for pointers
+** the tracker does not know.
+*/
+
+PRELOAD_API void	*malloc(size_t size)
+{
+	void	*ptr;
+
+	if (ALLOC_SITES || HEAP_PROFILE)
+		site_enter_sa(__builtin_return_address(0));
+	if (preload_enter_sa())
+		ptr = preload_alloc_sa(size, BLOCK_ALIGN, false);
+	else
+		ptr = __libc_malloc(size);
+	preload_leave_sa();
+	return (ptr);
+}
+
+PRELOAD_API void	*calloc(size_t count, size_t size)
+{
+	void	*ptr;
+
+	if (size != 0 && count > SIZE_MAX / size)
+		return (errno = ENOMEM, NULL);
+	if (ALLOC_SITES || HEAP_PROFILE)
+		site_enter_sa(__builtin_return_address(0));
+	if (preload_enter_sa())
+		ptr = preload_alloc_sa(count * size, BLOCK_ALIGN, true);
+	else
+		ptr = __libc_calloc(count, size);
+	preload_leave_sa();
+	return (ptr);
+}
+
+PRELOAD_API void	free(void *ptr)
+{
+	if (!ptr)
+		return ;
+	if (!preload_enter_sa() || preload_release_sa(ptr) == ERROR)
+		__libc_free(ptr);
+	preload_leave_sa();
+}
+
+PRELOAD_API void	*realloc(void *ptr, size_t size)
+{
+	void	*new_ptr;
+
+	if (!ptr)
+		return (malloc(size));
+	if (size == 0)
+		return (free(ptr), NULL);
+	if (ALLOC_SITES || HEAP_PROFILE)
+		site_enter_sa(__builtin_return_address(0));
+	if (preload_enter_sa())
+		new_ptr = preload_realloc_sa(ptr, size);
+	else
+		new_ptr = __libc_realloc(ptr, size);
+	preload_leave_sa();
+	return (new_ptr);
+}
+
+/*
+** Alignments past a page are beyond ALLOCATE_ALIGNED, glibc serves them.
+*/
+PRELOAD_API int	posix_memalign(void **memptr, size_t align, size_t size)
+{
+	void	*ptr;
+
+	if (align == 0 || align % sizeof(void *) != 0
+		|| (align & (align - 1)) != 0)
+		return (EINVAL);
+	if (ALLOC_SITES || HEAP_PROFILE)
+		site_enter_sa(__builtin_return_address(0));
+	if (preload_enter_sa() && align <= (size_t)sysconf(_SC_PAGESIZE))
+		ptr = preload_alloc_sa(size, align, false);
+	else
+		ptr = __libc_memalign(align, size);
+	preload_leave_sa();
+	if (!ptr)
+		return (ENOMEM);
+	*memptr = ptr;
+	return (0);
+}
@@ -0,0 +1,88 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_preload_size.c                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 18:02:44 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 19:53:32 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+#include <dlfcn.h>
+
+static void	read_size(t_allocation *entry, void *arg)
+{
+	*(size_t *)arg = entry->size;
+}
+
+/*
+** With magazines the entry may sit in another thread's magazine; it is
+** moved into the tracker first, as resize_in_place_sa() does.
+*/
+static int	tracked_size(const void *ptr, size_t *size)
+{
+	if (tracker_update_sa(tracker_sa(), ptr, read_size, size) == SUCCESS)
+		return (SUCCESS);
+	if (!THREAD_MAGAZINES || magazine_spill_sa(tracker_sa(), ptr) == ERROR)
+		return (ERROR);
+	return (tracker_update_sa(tracker_sa(), ptr, read_size, size));
+}
+
+/*
+** The old block stays tracked, and untouched, until its contents are in
+** the new one, so a failed realloc() leaves it as it was.
+*/
+void	*preload_realloc_sa(void *ptr, size_t size)
+{
+	t_allocation	old;
+	void			*new_ptr;
+	size_t			old_size;
+
+	if (resize_in_place_sa(tracker_sa(), ptr, (size_t[2]){size, size},
+		&new_ptr) == SUCCESS)
+		return (new_ptr);
+	if (tracked_size(ptr, &old_size) == ERROR)
+		return (__libc_realloc(ptr, size));
+	new_ptr = preload_alloc_sa(size, BLOCK_ALIGN, false);
+	if (!new_ptr)
+		return (NULL);
+	if (old_size < size)
+		size = old_size;
+	ft_memcpy_sa(new_ptr, ptr, size);
+	if (forget_sa(tracker_sa(), ptr, &old) == ERROR)
+		return (new_ptr);
+	if (MEMORY_FENCING && !page_guarded_sa(block_total_sa(&old)))
+		check_memfen(old.user_ptr, old.size);
+	release_block_sa(&old);
+	return (new_ptr);
+}
+
+/*
+** glibc's own version, looked up once; dlsym() allocates, which is fine
+** here since the caller has entered the tracker.
+*/
+static size_t	libc_usable_size(void *ptr)
+{
+	static size_t	(*real)(void *);
+
+	if (!real)
+		real = (size_t (*)(void *))dlsym(RTLD_NEXT, "malloc_usable_size");
+	if (!real)
+		return (0);
+	return (real(ptr));
+}
+
+PRELOAD_API size_t	malloc_usable_size(void *ptr)
+{
+	size_t	size;
+
+	if (!ptr)
+		return (0);
+	if (!preload_enter_sa() || tracked_size(ptr, &size) == ERROR)
+		size = libc_usable_size(ptr);
+	preload_leave_sa();
+	return (size);
+}
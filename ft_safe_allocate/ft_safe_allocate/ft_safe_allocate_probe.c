@@ -0,0 +1,93 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_probe.c                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 14:18:37 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 15:26:15 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+size_t	probe_distance_sa(const void *ptr, size_t pos, size_t capacity)
+{
+	return ((pos - (hash_ptr(ptr) & (capacity - 1))) & (capacity - 1));
+}
+
+static void	put_slot(t_allocation *slots, size_t pos, const t_allocation *entry)
+{
+	slots[pos] = *entry;
+	header_set_slot_sa(&slots[pos], pos);
+}
+
+/*
+** Returns the distance of the evicted entry, now carried, from its home.
+*/
+static size_t	swap_slot(
+	t_allocation *slots, size_t capacity, size_t pos, t_allocation *carry)
+{
+	t_allocation	evicted;
+
+	evicted = slots[pos];
+	put_slot(slots, pos, carry);
+	*carry = evicted;
+	return (probe_distance_sa(carry->user_ptr, pos, capacity));
+}
+
+/*
+** Robin Hood insertion: an entry that has probed further than the one in
+** its way takes that slot, and the evicted entry carries on. Probe lengths
+** stay close to the mean instead of piling up into long chains. A carried
+** entry's distance only grows until it is placed, so the longest distance
+** reached is the longest one placed.
+*/
+size_t	table_place_sa(
+	t_allocation *slots, size_t capacity, const t_allocation *entry)
+{
+	t_allocation	carry;
+	size_t			pos;
+	size_t			dist;
+	size_t			longest;
+
+	carry = *entry;
+	pos = hash_ptr(carry.user_ptr) & (capacity - 1);
+	dist = 0;
+	longest = 0;
+	while (slots[pos].user_ptr)
+	{
+		if (probe_distance_sa(slots[pos].user_ptr, pos, capacity) < dist)
+			dist = swap_slot(slots, capacity, pos, &carry);
+		pos = (pos + 1) & (capacity - 1);
+		dist++;
+		if (dist > longest)
+			longest = dist;
+	}
+	put_slot(slots, pos, &carry);
+	if (INSTRUMENT)
+		instr_probe_sa(INSTR_PLACE,
+			probe_distance_sa(entry->user_ptr, pos, capacity) + 1);
+	return (longest);
+}
+
+/*
+** Backward-shift deletion: the entries after the hole move back one slot
+** until a gap or an entry sitting in its home slot. No tombstones are left,
+** so a miss stops at the first gap.
+*/
+void	table_shift_sa(t_allocation *slots, size_t capacity, size_t pos)
+{
+	size_t	next;
+
+	next = (pos + 1) & (capacity - 1);
+	while (slots[next].user_ptr
+		&& probe_distance_sa(slots[next].user_ptr, next, capacity) > 0)
+	{
+		put_slot(slots, pos, &slots[next]);
+		pos = next;
+		next = (pos + 1) & (capacity - 1);
+	}
+	ft_memset_sa(&slots[pos], 0, sizeof(t_allocation));
+}
@@ -0,0 +1,83 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_probe_stats.c                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 14:18:38 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 18:50:12 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+#if !LOCK_FREE_TRACKING
+
+static void	count_slots(const t_allocation *slots, size_t capacity,
+	size_t *hist, size_t n)
+{
+	size_t	dist;
+	size_t	i;
+
+	i = 0;
+	while (slots && i < capacity)
+	{
+		if (slots[i].user_ptr)
+		{
+			dist = probe_distance_sa(slots[i].user_ptr, i, capacity);
+			if (dist >= n)
+				dist = n - 1;
+			hist[dist]++;
+		}
+		i++;
+	}
+}
+
+void	tracker_probe_histogram_sa(t_tracker *tracker, size_t *hist, size_t n)
+{
+	t_table	*table;
+	int		i;
+
+	ft_memset_sa(hist, 0, n * sizeof(size_t));
+	i = 0;
+	while (n > 0 && i < SHARD_COUNT)
+	{
+		pthread_mutex_lock(&tracker->shards[i].lock);
+		table = &tracker->shards[i].table;
+		while (table)
+		{
+			count_slots(table->slots, table->capacity, hist, n);
+			table = table->old;
+		}
+		pthread_mutex_unlock(&tracker->shards[i++].lock);
+	}
+}
+
+#else
+
+void	tracker_probe_histogram_sa(t_tracker *tracker, size_t *hist, size_t n)
+{
+	void	*key;
+	size_t	dist;
+	size_t	i;
+
+	ft_memset_sa(hist, 0, n * sizeof(size_t));
+	i = 0;
+	while (n > 0 && i < LOCKFREE_TABLE_SIZE)
+	{
+		key = atomic_load_explicit(&tracker->slots[i].key,
+				memory_order_acquire);
+		key = (void *)((uintptr_t)key & ~(uintptr_t)SLOT_BUSY_BIT);
+		if (key && key != SLOT_TOMBSTONE)
+		{
+			dist = probe_distance_sa(key, i, LOCKFREE_TABLE_SIZE);
+			if (dist >= n)
+				dist = n - 1;
+			hist[dist]++;
+		}
+		i++;
+	}
+}
+
+#endif
@@ -0,0 +1,113 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_rehash.c                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 12:47:18 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 19:57:03 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+/*
+** The current array is chained even when empty: the next migration step
+** finds nothing in it and frees it.
+*/
+int	table_grow_sa(t_table *table, size_t extra)
+{
+	t_allocation	*slots;
+	t_table			*old;
+	size_t			capacity;
+
+	capacity = SHARD_TABLE_SIZE;
+	while ((table->count + table->pending + extra) * 200
+		> capacity * TABLE_MAX_LOAD)
+		capacity *= 2;
+	slots = ft_calloc_sa(capacity, sizeof(t_allocation));
+	old = RAW_MALLOC(sizeof(t_table));
+	if (!slots || !old)
+		return (RAW_FREE(slots), RAW_FREE(old), ERROR);
+	*old = *table;
+	old->pending = 0;
+	old->migrate_pos = 0;
+	table->old = old;
+	table->pending += table->count;
+	table->slots = slots;
+	table->capacity = capacity;
+	table->count = 0;
+	table->max_probe = 0;
+	return (SUCCESS);
+}
+
+/*
+** The old slot is emptied by a backward shift, which may pull the next
+** entry into it, so migrate_pos only moves on past an empty slot. Nothing
+** before migrate_pos is ever filled again, so no chain breaks.
+*/
+static void	migrate_slot(t_table *table, t_table *old)
+{
+	size_t	longest;
+
+	longest = table_place_sa(table->slots, table->capacity,
+			&old->slots[old->migrate_pos]);
+	if (longest > table->max_probe)
+		table->max_probe = longest;
+	table->count++;
+	table->pending--;
+	old->count--;
+	table_shift_sa(old->slots, old->capacity, old->migrate_pos);
+}
+
+void	table_migrate_sa(t_table *table, size_t steps)
+{
+	t_table	*old;
+
+	while (table->old && steps-- > 0)
+	{
+		old = table->old;
+		if (old->count == 0 || old->migrate_pos == old->capacity)
+		{
+			table->old = old->old;
+			RAW_FREE(old->slots);
+			RAW_FREE(old);
+		}
+		else if (old->slots[old->migrate_pos].user_ptr)
+			migrate_slot(table, old);
+		else
+			old->migrate_pos++;
+	}
+}
+
+void	table_foreach_sa(
+	t_table *table, void (*fn)(t_allocation *, void *), void *arg)
+{
+	size_t	i;
+
+	i = 0;
+	while (table->slots && i < table->capacity)
+	{
+		if (table->slots[i].user_ptr)
+			fn(&table->slots[i], arg);
+		i++;
+	}
+	if (table->old)
+		table_foreach_sa(table->old, fn, arg);
+}
+
+void	table_release_sa(t_table *table)
+{
+	t_table	*old;
+
+	RAW_FREE(table->slots);
+	while (table->old)
+	{
+		old = table->old;
+		table->old = old->old;
+		RAW_FREE(old->slots);
+		RAW_FREE(old);
+	}
+	ft_memset_sa(table, 0, sizeof(t_table));
+}
@@ -0,0 +1,101 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_rekey.c                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 19:27:24 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 19:43:36 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+#if !LOCK_FREE_TRACKING
+
+static void	lock_shard(t_shard *shard)
+{
+	if (!INSTRUMENT)
+		pthread_mutex_lock(&shard->lock);
+	else
+		instr_lock_sa(&shard->lock);
+}
+
+/*
+** Within one shard the old slot is released first, so the entry always
+** finds room. Across shards the new entry goes in first, and the old one
+** leaves either way: its block is gone.
+*/
+static int	replace_entry(t_shard *from, t_shard *to, t_allocation *slot,
+	const t_allocation *entry)
+{
+	int	status;
+
+	if (slot->user_ptr == entry->user_ptr)
+	{
+		*slot = *entry;
+		return (SUCCESS);
+	}
+	if (from == to)
+	{
+		table_remove_sa(&from->table, slot);
+		return (table_insert_sa(&to->table, entry));
+	}
+	status = table_insert_sa(&to->table, entry);
+	table_remove_sa(&from->table, slot);
+	return (status);
+}
+
+/*
+** Both shards are locked in array order, so two blocks moving in opposite
+** directions cannot deadlock. The old block may be gone, so its header is
+** not read for a slot hint.
+*/
+int	tracker_rekey_sa(t_tracker *tracker, const void *ptr,
+	const t_allocation *entry, t_lf_slot *claimed)
+{
+	t_shard			*from;
+	t_shard			*to;
+	t_allocation	*slot;
+	int				status;
+
+	(void)claimed;
+	from = shard_for_sa(tracker, ptr);
+	to = shard_for_sa(tracker, entry->user_ptr);
+	if (to < from)
+		lock_shard(to);
+	lock_shard(from);
+	if (to > from)
+		lock_shard(to);
+	status = ERROR;
+	slot = table_probe_sa(&from->table, ptr);
+	if (slot)
+		status = replace_entry(from, to, slot, entry);
+	pthread_mutex_unlock(&from->lock);
+	if (to != from)
+		pthread_mutex_unlock(&to->lock);
+	return (status);
+}
+
+#else
+
+int	tracker_rekey_sa(t_tracker *tracker, const void *ptr,
+	const t_allocation *entry, t_lf_slot *claimed)
+{
+	int	status;
+
+	if (entry->user_ptr == ptr)
+	{
+		claimed->entry = *entry;
+		atomic_store_explicit(&claimed->key, (void *)ptr,
+			memory_order_release);
+		return (SUCCESS);
+	}
+	status = tracker_insert_sa(tracker, entry);
+	atomic_store_explicit(&claimed->key, SLOT_TOMBSTONE, memory_order_release);
+	atomic_fetch_sub(&tracker->live, 1);
+	return (status);
+}
+
+#endif
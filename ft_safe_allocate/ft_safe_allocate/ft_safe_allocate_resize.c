@@ -0,0 +1,112 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_resize.c                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 13:29:04 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 19:43:36 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+/*
+** Page-guarded blocks are always copied. Slab blocks only stay in place
+** within their size class, and a block never crosses SLAB_MAX_BLOCK or
+** MMAP_MIN_BLOCK here since its allocator would change. Mapped blocks are
+** remapped, everything else goes to realloc(), which extends or shrinks
+** the chunk in place when it can.
+*/
+static unsigned char	*resize_block(
+	unsigned char *block, size_t old_total, size_t new_total)
+{
+	if (page_guarded_sa(old_total) || page_guarded_sa(new_total))
+		return (NULL);
+	if (SLAB_ALLOCATOR
+		&& (old_total <= SLAB_MAX_BLOCK || new_total <= SLAB_MAX_BLOCK))
+	{
+		if (old_total <= SLAB_MAX_BLOCK && new_total <= SLAB_MAX_BLOCK
+			&& (old_total + SLAB_ALIGN - 1) / SLAB_ALIGN
+			== (new_total + SLAB_ALIGN - 1) / SLAB_ALIGN)
+			return (block);
+		return (NULL);
+	}
+	if (old_total >= MMAP_MIN_BLOCK || new_total >= MMAP_MIN_BLOCK)
+		return (remap_block_sa(block, old_total, new_total));
+	return (RAW_REALLOC(block, new_total));
+}
+
+/*
+** Bytes past size[1] (the amount REALLOC promises to keep) are zeroed, as
+** the copying path would have left them. Pages a remap added past the old
+** mapping are already zero and stay untouched.
+*/
+static void	clear_tail(
+	unsigned char *block, const size_t *size, size_t old_size)
+{
+	size_t	keep;
+	size_t	end;
+
+	keep = size[1];
+	if (keep > old_size)
+		keep = old_size;
+	if (keep > size[0])
+		keep = size[0];
+	end = size[0];
+	if (size[0] + BLOCK_OVERHEAD >= MMAP_MIN_BLOCK
+		&& end > mapped_size_sa(old_size + BLOCK_OVERHEAD) - BLOCK_PREFIX)
+		end = mapped_size_sa(old_size + BLOCK_OVERHEAD) - BLOCK_PREFIX;
+	ft_memset_sa(block + BLOCK_PREFIX + keep, 0, end - keep);
+}
+
+/*
+** No block was allocated or freed, so only live_bytes (and peak_bytes)
+** move, by the size difference; the allocation and free totals do not.
+*/
+static void	rewrite_block(
+	t_allocation *entry, unsigned char *block, const size_t *size)
+{
+	clear_tail(block, size, entry->size);
+	stats_remove_sa(0, entry->size);
+	stats_add_sa(0, size[0]);
+	if (ALLOC_SITES)
+		site_account_sa(entry, false);
+	if (HEAP_PROFILE)
+		sample_release_sa(entry);
+	entry->original_ptr = block;
+	entry->user_ptr = block + BLOCK_PREFIX;
+	entry->size = size[0];
+	if (ALLOC_SITES || HEAP_PROFILE)
+		site_tag_sa(entry);
+	if (ALLOC_SITES)
+		site_account_sa(entry, true);
+	if (MEMORY_FENCING && !page_guarded_sa(size[0] + BLOCK_OVERHEAD))
+		setup_memfen(block + BLOCK_PREFIX - GUARD_SIZE, size[0]);
+	if (FENCE_SCRUB)
+		scrub_stamp_sa(entry, scrub_now_sa());
+	if (INLINE_HEADER)
+	{
+		((t_header *)block)->size = size[0];
+		((t_header *)block)->magic = HEADER_MAGIC ^ (uintptr_t)entry->user_ptr;
+	}
+}
+
+void	resize_entry_sa(t_allocation *entry, t_resize *resize)
+{
+	unsigned char	*block;
+
+	if (!entry->original_ptr
+		|| block_total_sa(entry) != entry->size + BLOCK_OVERHEAD
+		|| resize->size[0] + BLOCK_OVERHEAD < resize->size[0])
+		return ;
+	if (MEMORY_FENCING && !page_guarded_sa(entry->size + BLOCK_OVERHEAD))
+		check_memfen(entry->user_ptr, entry->size);
+	block = resize_block(entry->original_ptr, entry->size + BLOCK_OVERHEAD,
+			resize->size[0] + BLOCK_OVERHEAD);
+	if (!block)
+		return ;
+	rewrite_block(entry, block, resize->size);
+	resize->user_ptr = entry->user_ptr;
+}
@@ -0,0 +1,41 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_resize_claim.c                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 19:52:18 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 19:43:36 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+/*
+** The entry stays tracked, parked, while realloc() or mremap() runs with
+** no lock held. A block that moved to a shard with no room left and no
+** memory to grow is handed back untracked rather than released: the old
+** pointer is gone by then.
+*/
+int	resize_in_place_sa(t_tracker *tracker, void *ptr, size_t *size,
+	void **new_ptr)
+{
+	t_resize		resize;
+	t_allocation	entry;
+	t_lf_slot		*claimed;
+
+	resize.size = size;
+	resize.user_ptr = NULL;
+	*new_ptr = NULL;
+	if (tracker_park_sa(tracker, ptr, &entry, &claimed) == ERROR
+		&& (!THREAD_MAGAZINES || magazine_spill_sa(tracker, ptr) == ERROR
+			|| tracker_park_sa(tracker, ptr, &entry, &claimed) == ERROR))
+		return (ERROR);
+	resize_entry_sa(&entry, &resize);
+	tracker_rekey_sa(tracker, ptr, &entry, claimed);
+	*new_ptr = resize.user_ptr;
+	if (!resize.user_ptr)
+		return (ERROR);
+	return (SUCCESS);
+}
@@ -0,0 +1,60 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_sample.c                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 15:58:47 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 19:49:20 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+_Thread_local t_sampler	g_sampler_sa
+	__attribute__((tls_model("initial-exec")));
+
+static t_heap	*heap_storage(void)
+{
+	static t_heap	heap = {PTHREAD_MUTEX_INITIALIZER, HEAP_SAMPLE_RATE,
+		HEAP_SAMPLE_RATE, NULL};
+
+	return (&heap);
+}
+
+/*
+** backtrace() loads the unwinder, through malloc(), the first time it runs.
+*/
+static void	heap_init(void)
+{
+	void	*frame;
+
+	heap_storage()->buckets = ft_calloc_sa(
+			HEAP_BUCKETS + 1, sizeof(t_heap_bucket));
+	backtrace(&frame, 1);
+	fork_handlers_sa();
+}
+
+t_heap	*heap_sa(void)
+{
+	static pthread_once_t	once = PTHREAD_ONCE_INIT;
+
+	pthread_once(&once, heap_init);
+	return (heap_storage());
+}
+
+void	*sample_rate_sa(const size_t *size)
+{
+	size_t	rate;
+
+	if (!HEAP_PROFILE)
+		return (NULL);
+	rate = HEAP_SAMPLE_RATE;
+	if (size)
+		rate = size[0];
+	if (rate)
+		atomic_store(&heap_sa()->scale, rate);
+	atomic_store(&heap_sa()->rate, rate);
+	return (NULL);
+}
@@ -0,0 +1,67 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_sample_bucket.c                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 15:59:09 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 15:59:09 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+static uint64_t	stack_hash(void *const *stack, size_t depth)
+{
+	uint64_t	hash;
+	size_t		i;
+
+	hash = depth;
+	i = 0;
+	while (i < depth)
+		hash = hash_ptr((void *)(hash ^ (uintptr_t)stack[i++]));
+	return (hash | 1);
+}
+
+static bool	same_stack(
+	const t_heap_bucket *bucket, void *const *stack, size_t depth)
+{
+	size_t	i;
+
+	if (bucket->depth != depth)
+		return (false);
+	i = 0;
+	while (i < depth && bucket->stack[i] == stack[i])
+		i++;
+	return (i == depth);
+}
+
+/*
+** Buckets are only claimed under the lock, and never given back.
+*/
+size_t	sample_bucket_sa(
+	t_heap_bucket *buckets, void *const *stack, size_t depth)
+{
+	t_heap_bucket	*bucket;
+	uint64_t		hash;
+	size_t			pos;
+	size_t			i;
+
+	hash = stack_hash(stack, depth);
+	pos = hash;
+	i = 0;
+	while (i++ < HEAP_BUCKETS)
+	{
+		bucket = &buckets[1 + (pos++ & (HEAP_BUCKETS - 1))];
+		if (!bucket->hash)
+		{
+			bucket->hash = hash;
+			bucket->depth = depth;
+			ft_memcpy_sa(bucket->stack, stack, depth * sizeof(void *));
+		}
+		if (bucket->hash == hash && same_stack(bucket, stack, depth))
+			return (bucket - buckets);
+	}
+	return (0);
+}
@@ -0,0 +1,66 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_sample_draw.c                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 15:58:48 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 15:58:48 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+/*
+** xorshift64*: the state must never be 0.
+*/
+static uint64_t	next_random(t_sampler *sampler)
+{
+	uint64_t	x;
+
+	x = sampler->rng;
+	x ^= x >> 12;
+	x ^= x << 25;
+	x ^= x >> 27;
+	sampler->rng = x;
+	return (x * 0x2545f4914f6cdd1dULL);
+}
+
+/*
+** -ln(u) for u = bits / 2^53 in (0, 1], without libm: u = m * 2^(e - 53)
+** with m in [1, 2), and ln(m) = 2 atanh((m - 1) / (m + 1)), whose series
+** converges fast since (m - 1) / (m + 1) < 1/3.
+*/
+static double	neg_log(uint64_t bits)
+{
+	double	t;
+	double	term;
+	double	sum;
+	int		e;
+	int		k;
+
+	e = 63 - __builtin_clzll(bits);
+	t = (double)bits / (double)(1ULL << e);
+	t = (t - 1.0) / (t + 1.0);
+	term = t;
+	sum = 0.0;
+	k = 1;
+	while (k < 24)
+	{
+		sum += term / k;
+		term *= t * t;
+		k += 2;
+	}
+	return ((53 - e) * 0.69314718055994530942 - 2.0 * sum);
+}
+
+int64_t	sample_draw_sa(t_sampler *sampler, size_t rate)
+{
+	uint64_t	bits;
+
+	if (rate > (size_t)(INT64_MAX / 64))
+		rate = INT64_MAX / 64;
+	bits = (next_random(sampler) >> 11) + 1;
+	return ((int64_t)(neg_log(bits) * (double)rate) + 1);
+}
@@ -0,0 +1,118 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_sample_dump.c                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 15:58:48 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 15:58:48 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+/*
+** "<inuse_count>: <inuse_bytes> [<alloc_count>: <alloc_bytes>] @"
+*/
+static size_t	counts_text(char *line, size_t len, const t_heap_bucket *b)
+{
+	len = diag_num_sa(line, len, b->inuse_count, 10);
+	len = diag_cat_sa(line, len, ": ");
+	len = diag_num_sa(line, len, b->inuse_bytes, 10);
+	len = diag_cat_sa(line, len, " [");
+	len = diag_num_sa(line, len, b->alloc_count, 10);
+	len = diag_cat_sa(line, len, ": ");
+	len = diag_num_sa(line, len, b->alloc_bytes, 10);
+	return (diag_cat_sa(line, len, "] @"));
+}
+
+static void	header_line(t_out *out, const t_heap *heap)
+{
+	t_heap_bucket	total;
+	char			line[DIAG_LINE];
+	size_t			len;
+	size_t			i;
+
+	ft_memset_sa(&total, 0, sizeof(t_heap_bucket));
+	i = 0;
+	while (heap->buckets && i <= HEAP_BUCKETS)
+	{
+		total.inuse_count += heap->buckets[i].inuse_count;
+		total.inuse_bytes += heap->buckets[i].inuse_bytes;
+		total.alloc_count += heap->buckets[i].alloc_count;
+		total.alloc_bytes += heap->buckets[i++].alloc_bytes;
+	}
+	len = diag_cat_sa(line, 0, "heap profile: ");
+	len = counts_text(line, len, &total);
+	len = diag_cat_sa(line, len, " heap_v2/");
+	len = diag_num_sa(line, len, atomic_load(&heap->scale), 10);
+	out_line_sa(out, line, diag_cat_sa(line, len, "\n"));
+}
+
+static void	bucket_line(t_out *out, const t_heap_bucket *bucket)
+{
+	char	line[DIAG_LINE];
+	size_t	len;
+	size_t	i;
+
+	if (!bucket->alloc_count)
+		return ;
+	out_line_sa(out, line, counts_text(line, 0, bucket));
+	i = 0;
+	while (i < bucket->depth)
+	{
+		len = diag_cat_sa(line, 0, " 0x");
+		len = diag_num_sa(line, len, (uintptr_t)bucket->stack[i++], 16);
+		out_line_sa(out, line, len);
+	}
+	out_line_sa(out, "\n", 1);
+}
+
+/*
+** pprof maps the return addresses to binaries with this copy of the maps.
+*/
+static void	copy_maps(t_out *out)
+{
+	char	buf[DIAG_LINE];
+	ssize_t	got;
+	int		fd;
+
+	out_line_sa(out, "\nMAPPED_LIBRARIES:\n", 19);
+	fd = open("/proc/self/maps", O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		return ;
+	got = read(fd, buf, sizeof(buf));
+	while (got > 0)
+	{
+		out_line_sa(out, buf, got);
+		got = read(fd, buf, sizeof(buf));
+	}
+	close(fd);
+}
+
+void	*heap_dump_sa(const size_t *size, const char *path)
+{
+	t_heap_bucket	*buckets;
+	t_out			out;
+	size_t			i;
+
+	if (!HEAP_PROFILE)
+		return (NULL);
+	out.fd = out_open_sa(size, path);
+	if (out.fd < 0)
+		return (diag_msg_sa(ERR_HEAP_TARGET), NULL);
+	out.len = 0;
+	pthread_mutex_lock(&heap_sa()->lock);
+	header_line(&out, heap_sa());
+	buckets = heap_sa()->buckets;
+	i = 0;
+	while (buckets && i <= HEAP_BUCKETS)
+		bucket_line(&out, &buckets[i++]);
+	pthread_mutex_unlock(&heap_sa()->lock);
+	copy_maps(&out);
+	out_flush_sa(&out);
+	if (path)
+		close(out.fd);
+	return (NULL);
+}
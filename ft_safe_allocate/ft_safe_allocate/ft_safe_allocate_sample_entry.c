@@ -0,0 +1,41 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_sample_entry.c                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 15:58:48 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 15:58:48 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+#if HEAP_PROFILE
+
+void	sample_mark_sa(t_allocation *entry, size_t mark)
+{
+	entry->sample = (uint32_t)mark;
+}
+
+size_t	sample_of_sa(const t_allocation *entry)
+{
+	return (entry->sample);
+}
+
+#else
+
+void	sample_mark_sa(t_allocation *entry, size_t mark)
+{
+	(void)entry;
+	(void)mark;
+}
+
+size_t	sample_of_sa(const t_allocation *entry)
+{
+	(void)entry;
+	return (0);
+}
+
+#endif
@@ -0,0 +1,103 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_sample_record.c                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 15:59:09 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 19:49:20 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+static void	seed(t_sampler *sampler)
+{
+	struct timespec	now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	sampler->rng = hash_ptr(sampler) ^ hash_ptr((void *)(uintptr_t)
+			(now.tv_sec * 1000000000ULL + now.tv_nsec));
+	if (!sampler->rng)
+		sampler->rng = 1;
+	sampler->seeded = true;
+}
+
+static void	count_sample(
+	t_heap *heap, t_allocation *entry, void *const *stack, size_t depth)
+{
+	t_heap_bucket	*bucket;
+
+	pthread_mutex_lock(&heap->lock);
+	bucket = &heap->buckets[sample_bucket_sa(heap->buckets, stack, depth)];
+	bucket->inuse_count++;
+	bucket->inuse_bytes += entry->size;
+	bucket->alloc_count++;
+	bucket->alloc_bytes += entry->size;
+	sample_mark_sa(entry, bucket - heap->buckets + 1);
+	pthread_mutex_unlock(&heap->lock);
+}
+
+/*
+** Each entry point noted its own return address, the first frame of the
+** program. The frames above it are the library's, however many it took
+** to get here. If it is not on the stack, say after a tail call, only the
+** frame of sample_record_sa() is dropped.
+*/
+static int	library_frames(void *const *frames, int depth)
+{
+	void	*caller;
+	int		i;
+
+	caller = g_site_caller_sa;
+	i = 1;
+	while (i < depth && i <= HEAP_SKIP_MAX)
+	{
+		if (frames[i] == caller)
+			return (i);
+		i++;
+	}
+	return (1);
+}
+
+void	sample_record_sa(t_sampler *sampler, t_allocation *entry)
+{
+	void	*frames[HEAP_DEPTH + HEAP_SKIP_MAX + 1];
+	size_t	rate;
+	int		depth;
+	int		skip;
+
+	rate = atomic_load_explicit(&heap_sa()->rate, memory_order_relaxed);
+	if (!sampler->seeded)
+		seed(sampler);
+	else if (rate && heap_sa()->buckets)
+	{
+		depth = backtrace(frames, HEAP_DEPTH + HEAP_SKIP_MAX + 1);
+		skip = library_frames(frames, depth);
+		depth -= skip;
+		if (depth < 0)
+			depth = 0;
+		if (depth > HEAP_DEPTH)
+			depth = HEAP_DEPTH;
+		count_sample(heap_sa(), entry, frames + skip, depth);
+	}
+	if (!rate)
+		rate = HEAP_SAMPLE_RATE;
+	sampler->countdown = sample_draw_sa(sampler, rate);
+}
+
+void	sample_release_sa(const t_allocation *entry)
+{
+	t_heap_bucket	*bucket;
+	size_t			mark;
+
+	mark = sample_of_sa(entry);
+	if (!mark)
+		return ;
+	pthread_mutex_lock(&heap_sa()->lock);
+	bucket = &heap_sa()->buckets[mark - 1];
+	bucket->inuse_count--;
+	bucket->inuse_bytes -= entry->size;
+	pthread_mutex_unlock(&heap_sa()->lock);
+}
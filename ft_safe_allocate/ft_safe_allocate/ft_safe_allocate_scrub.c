@@ -0,0 +1,40 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_scrub.c                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 16:18:01 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 18:38:04 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+t_scrub	*scrub_sa(void)
+{
+	static t_scrub	scrub = {PTHREAD_MUTEX_INITIALIZER, {0, 0}};
+
+	return (&scrub);
+}
+
+/*
+** The child of a fork() has no scrubber: only the thread calling fork()
+** is copied.
+*/
+static void	start_scrubber(void)
+{
+	pthread_t	thread;
+
+	fork_handlers_sa();
+	if (pthread_create(&thread, NULL, scrub_loop_sa, scrub_sa()) == 0)
+		pthread_detach(thread);
+}
+
+void	scrub_start_sa(void)
+{
+	static pthread_once_t	once = PTHREAD_ONCE_INIT;
+
+	pthread_once(&once, start_scrubber);
+}
@@ -0,0 +1,50 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_scrub_check.c                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 16:18:01 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 17:16:11 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+static void	report(const t_allocation *entry, const char *msg, uint64_t now)
+{
+	char	line[DIAG_LINE];
+	size_t	len;
+
+	len = diag_cat_sa(line, 0, msg);
+	len = diag_num_sa(line, len, (uintptr_t)entry->user_ptr, 16);
+	len = diag_cat_sa(line, len, ERR_SCRUB_AGE);
+	len = diag_num_sa(line, len, now - scrub_stamp_of_sa(entry), 10);
+	len = diag_cat_sa(line, len, ERR_SCRUB_AGE_UNIT);
+	diag_push_sa(line, len);
+}
+
+/*
+** Page-guarded blocks have no software end guard; the MMU checks them.
+** Blocks given to ADD_TO_TRACK have no guards at all.
+*/
+void	scrub_entry_sa(t_allocation *entry, void *arg)
+{
+	uint64_t	now;
+
+	now = *(uint64_t *)arg;
+	if (!entry->original_ptr || scrub_stamp_of_sa(entry) == SCRUB_BAD
+		|| page_guarded_sa(block_total_sa(entry)))
+		return ;
+	if (!start_intact_sa(entry->user_ptr))
+		report(entry, ERR_CORRUPTION_START, now);
+	else if (!end_intact_sa(entry->user_ptr, entry->size))
+		report(entry, ERR_CORRUPTION_END, now);
+	else
+	{
+		scrub_stamp_sa(entry, now);
+		return ;
+	}
+	scrub_stamp_sa(entry, SCRUB_BAD);
+}
@@ -0,0 +1,41 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_scrub_entry.c                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 16:18:01 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 16:18:01 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+#if FENCE_SCRUB
+
+void	scrub_stamp_sa(t_allocation *entry, uint64_t when)
+{
+	entry->verified = when;
+}
+
+uint64_t	scrub_stamp_of_sa(const t_allocation *entry)
+{
+	return (entry->verified);
+}
+
+#else
+
+void	scrub_stamp_sa(t_allocation *entry, uint64_t when)
+{
+	(void)entry;
+	(void)when;
+}
+
+uint64_t	scrub_stamp_of_sa(const t_allocation *entry)
+{
+	(void)entry;
+	return (0);
+}
+
+#endif
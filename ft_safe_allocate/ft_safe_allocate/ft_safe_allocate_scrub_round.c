@@ -0,0 +1,76 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_scrub_round.c                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 16:18:01 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 16:18:01 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+uint64_t	scrub_now_sa(void)
+{
+	struct timespec	now;
+
+	clock_gettime(CLOCK_MONOTONIC_COARSE, &now);
+	return (now.tv_sec * 1000ULL + now.tv_nsec / 1000000);
+}
+
+static uint64_t	now_us(void)
+{
+	struct timespec	now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec * 1000000ULL + now.tv_nsec / 1000);
+}
+
+/*
+** Magazines hold at most MAGAZINE_SIZE entries each, so they are checked
+** in one go at the end of each pass over the tracker.
+*/
+static void	scrub_round(t_scrub *scrub)
+{
+	uint64_t	deadline;
+	uint64_t	stamp;
+	bool		wrapped;
+
+	deadline = now_us() + SCRUB_SLICE_US;
+	wrapped = false;
+	while (!wrapped && now_us() < deadline)
+	{
+		stamp = scrub_now_sa();
+		pthread_mutex_lock(&scrub->lock);
+		wrapped = tracker_step_sa(tracker_sa(), scrub->cursor,
+				scrub_entry_sa, &stamp);
+		pthread_mutex_unlock(&scrub->lock);
+	}
+	if (THREAD_MAGAZINES && wrapped)
+	{
+		stamp = scrub_now_sa();
+		magazine_lock_all_sa();
+		magazine_foreach_sa(scrub_entry_sa, &stamp);
+		magazine_unlock_all_sa();
+	}
+}
+
+/*
+** A round ends early once it completes a pass, so an idle program with
+** few blocks is checked once per period rather than in a busy loop.
+*/
+void	*scrub_loop_sa(void *arg)
+{
+	struct timespec	pause;
+
+	pause.tv_sec = SCRUB_PERIOD_MS / 1000;
+	pause.tv_nsec = SCRUB_PERIOD_MS % 1000 * 1000000L;
+	while (1)
+	{
+		nanosleep(&pause, NULL);
+		scrub_round(arg);
+	}
+	return (NULL);
+}
@@ -0,0 +1,99 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_scrub_step.c                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 16:18:01 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 18:50:12 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+#if LOCK_FREE_TRACKING
+
+/*
+** A claimed slot cannot be released under the scrubber: the free waits on
+** SLOT_BUSY_BIT like it does for any other claim.
+*/
+bool	tracker_step_sa(t_tracker *tracker, size_t *cursor,
+	void (*fn)(t_allocation *, void *), void *arg)
+{
+	t_lf_slot	*slot;
+	size_t		end;
+
+	end = cursor[1] + SCRUB_STEP;
+	while (cursor[1] < end && cursor[1] < LOCKFREE_TABLE_SIZE)
+	{
+		slot = &tracker->slots[cursor[1]++];
+		if (lf_claim_live_sa(slot) == SUCCESS)
+		{
+			fn(&slot->entry, arg);
+			atomic_store_explicit(&slot->key, slot->entry.user_ptr,
+				memory_order_release);
+		}
+	}
+	if (cursor[1] < LOCKFREE_TABLE_SIZE)
+		return (false);
+	lf_spill_walk_sa(tracker, fn, arg, false);
+	cursor[1] = 0;
+	return (true);
+}
+
+#else
+
+/*
+** Positions past the current array continue into the ones being migrated.
+*/
+static t_allocation	*slot_at(t_table *table, size_t pos)
+{
+	while (table && pos >= table->capacity)
+	{
+		pos -= table->capacity;
+		table = table->old;
+	}
+	if (!table)
+		return (NULL);
+	return (&table->slots[pos]);
+}
+
+static void	step_table(t_table *table, size_t *pos,
+	void (*fn)(t_allocation *, void *), void *arg)
+{
+	t_allocation	*slot;
+	size_t			end;
+
+	end = *pos + SCRUB_STEP;
+	slot = slot_at(table, *pos);
+	while (*pos < end && slot)
+	{
+		if (slot->user_ptr)
+			fn(slot, arg);
+		slot = slot_at(table, ++(*pos));
+	}
+}
+
+bool	tracker_step_sa(t_tracker *tracker, size_t *cursor,
+	void (*fn)(t_allocation *, void *), void *arg)
+{
+	t_shard	*shard;
+	bool	done;
+
+	shard = &tracker->shards[cursor[0]];
+	if (!INSTRUMENT)
+		pthread_mutex_lock(&shard->lock);
+	else
+		instr_lock_sa(&shard->lock);
+	step_table(&shard->table, &cursor[1], fn, arg);
+	done = (slot_at(&shard->table, cursor[1]) == NULL);
+	pthread_mutex_unlock(&shard->lock);
+	if (!done)
+		return (false);
+	cursor[1] = 0;
+	cursor[0] = (cursor[0] + 1) % SHARD_COUNT;
+	return (cursor[0] == 0);
+}
+
+#endif
@@ -0,0 +1,52 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_site.c                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 15:28:52 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 19:49:20 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+_Thread_local void	*g_site_caller_sa
+	__attribute__((tls_model("initial-exec")));
+
+t_sites	*sites_sa(void)
+{
+	static t_sites	sites;
+
+	return (&sites);
+}
+
+/*
+** A slot's caller never changes once claimed, so a lookup that meets an
+** empty slot knows the site is new and claims it. Losing that race to the
+** same caller is as good as winning it.
+*/
+size_t	site_intern_sa(void *caller)
+{
+	t_site	*slot;
+	void	*seen;
+	size_t	pos;
+	size_t	i;
+
+	if (!caller)
+		return (0);
+	pos = hash_ptr(caller);
+	i = 0;
+	while (i++ < SITE_SLOTS)
+	{
+		slot = &sites_sa()->slots[1 + (pos++ & (SITE_SLOTS - 1))];
+		seen = atomic_load_explicit(&slot->caller, memory_order_acquire);
+		if (!seen)
+			atomic_compare_exchange_strong_explicit(&slot->caller, &seen,
+				caller, memory_order_acq_rel, memory_order_acquire);
+		if (!seen || seen == caller)
+			return (slot - sites_sa()->slots);
+	}
+	return (0);
+}
@@ -0,0 +1,31 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_site_account.c                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 15:43:47 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 15:53:17 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+void	site_account_sa(const t_allocation *entry, bool add)
+{
+	t_site	*site;
+
+	site = &sites_sa()->slots[site_of_sa(entry)];
+	if (!add)
+	{
+		atomic_fetch_sub_explicit(&site->live_blocks, 1, memory_order_relaxed);
+		atomic_fetch_sub_explicit(
+			&site->live_bytes, entry->size, memory_order_relaxed);
+		return ;
+	}
+	atomic_fetch_add_explicit(&site->total_allocs, 1, memory_order_relaxed);
+	atomic_fetch_add_explicit(&site->live_blocks, 1, memory_order_relaxed);
+	atomic_fetch_add_explicit(
+		&site->live_bytes, entry->size, memory_order_relaxed);
+}
@@ -0,0 +1,43 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_site_entry.c                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 15:28:53 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 19:49:20 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+#if ALLOC_SITES || HEAP_PROFILE
+
+void	site_tag_sa(t_allocation *entry)
+{
+	entry->site = 0;
+	entry->sample = 0;
+	if (ALLOC_SITES)
+		entry->site = (uint32_t)site_intern_sa(g_site_caller_sa);
+}
+
+size_t	site_of_sa(const t_allocation *entry)
+{
+	return (entry->site);
+}
+
+#else
+
+void	site_tag_sa(t_allocation *entry)
+{
+	(void)entry;
+}
+
+size_t	site_of_sa(const t_allocation *entry)
+{
+	(void)entry;
+	return (0);
+}
+
+#endif
@@ -0,0 +1,70 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_site_report.c                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 15:28:53 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 15:42:13 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+static void	copy_site(t_site *site, t_site_stats *stats)
+{
+	stats->caller = atomic_load_explicit(&site->caller, memory_order_acquire);
+	stats->total_allocs = atomic_load_explicit(
+			&site->total_allocs, memory_order_relaxed);
+	stats->live_blocks = atomic_load_explicit(
+			&site->live_blocks, memory_order_relaxed);
+	stats->live_bytes = atomic_load_explicit(
+			&site->live_bytes, memory_order_relaxed);
+}
+
+/*
+** Keeps out[0..filled) ordered by decreasing live_bytes; once cap entries
+** are filled, a site smaller than all of them is left out.
+*/
+static size_t	insert_sorted(t_site_stats *out, size_t filled, size_t cap,
+	const t_site_stats *site)
+{
+	size_t	pos;
+
+	pos = filled;
+	while (pos > 0 && out[pos - 1].live_bytes < site->live_bytes)
+	{
+		if (pos < cap)
+			out[pos] = out[pos - 1];
+		pos--;
+	}
+	if (pos < cap)
+		out[pos] = *site;
+	if (filled < cap)
+		filled++;
+	return (filled);
+}
+
+size_t	get_sites_sa(const size_t *size, t_site_stats *out)
+{
+	t_sites			*sites;
+	t_site_stats	site;
+	size_t			filled;
+	size_t			i;
+
+	if (!ALLOC_SITES)
+		return (0);
+	sites = sites_sa();
+	filled = 0;
+	i = 0;
+	while (i <= SITE_SLOTS)
+	{
+		copy_site(&sites->slots[i++], &site);
+		if ((site.caller || site.total_allocs) && (!size || !out))
+			filled++;
+		else if (site.caller || site.total_allocs)
+			filled = insert_sorted(out, filled, size[0], &site);
+	}
+	return (filled);
+}
@@ -0,0 +1,101 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_slab.c                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 13:23:17 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 18:38:04 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+static t_slab_class	*slab_storage(void)
+{
+	static t_slab_class	classes[SLAB_CLASSES] = {
+	[0 ... SLAB_CLASSES - 1] = {.lock = PTHREAD_MUTEX_INITIALIZER}};
+
+	return (classes);
+}
+
+void	slab_locks_sa(int (*op)(pthread_mutex_t *))
+{
+	int	i;
+
+	i = 0;
+	while (i < SLAB_CLASSES)
+		op(&slab_storage()[i++].lock);
+}
+
+/*
+** Blocks are carved from the current slab in address order. A fresh slab
+** comes zeroed from mmap, so only recycled blocks need a memset.
+*/
+static void	*carve(t_slab_class *class, size_t class_size)
+{
+	void	*block;
+
+	if (class->remaining < class_size)
+	{
+		block = mmap(NULL, SLAB_SIZE, PROT_READ | PROT_WRITE,
+				MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (block == MAP_FAILED)
+			return (NULL);
+		class->bump = block;
+		class->remaining = SLAB_SIZE;
+	}
+	block = class->bump;
+	class->bump += class_size;
+	class->remaining -= class_size;
+	return (block);
+}
+
+void	*slab_alloc_sa(size_t total, bool zero)
+{
+	t_slab_class	*class;
+	size_t			class_size;
+	void			*block;
+	bool			recycled;
+
+	fork_handlers_sa();
+	if (total == 0)
+		total = 1;
+	class = &slab_storage()[(total - 1) / SLAB_ALIGN];
+	class_size = ((total - 1) / SLAB_ALIGN + 1) * SLAB_ALIGN;
+	pthread_mutex_lock(&class->lock);
+	block = class->free_list;
+	recycled = (block != NULL);
+	if (recycled)
+		class->free_list = *(void **)block;
+	else
+		block = carve(class, class_size);
+	pthread_mutex_unlock(&class->lock);
+	if (recycled && zero)
+		ft_memset_sa(block, 0, class_size);
+	return (block);
+}
+
+void	block_free_sa(void *block, size_t total)
+{
+	t_slab_class	*class;
+
+	if (!SLAB_ALLOCATOR || total > SLAB_MAX_BLOCK)
+	{
+		if (page_guarded_sa(total))
+			guard_unmap_sa(block, total);
+		else if (total >= MMAP_MIN_BLOCK)
+			munmap_block_sa(block, total);
+		else
+			RAW_FREE(block);
+		return ;
+	}
+	if (total == 0)
+		total = 1;
+	class = &slab_storage()[(total - 1) / SLAB_ALIGN];
+	pthread_mutex_lock(&class->lock);
+	*(void **)block = class->free_list;
+	class->free_list = block;
+	pthread_mutex_unlock(&class->lock);
+}
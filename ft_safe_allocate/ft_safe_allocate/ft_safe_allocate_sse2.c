@@ -0,0 +1,104 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_sse2.c                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 13:56:04 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 13:56:04 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+#if SIMD_MEMOPS
+
+# include <immintrin.h>
+
+/*
+** First vector boundary past b. The caller has already stored the first
+** vector unaligned, so the bytes skipped here are written.
+*/
+static __m128i	*next_vector(void *b)
+{
+	return ((__m128i *)(((uintptr_t)b + sizeof(__m128i))
+		& ~(uintptr_t)(sizeof(__m128i) - 1)));
+}
+
+__attribute__((target("sse2")))
+static void	set_vectors(__m128i *vd, __m128i v, size_t count)
+{
+	while (count >= 4)
+	{
+		_mm_store_si128(vd, v);
+		_mm_store_si128(vd + 1, v);
+		_mm_store_si128(vd + 2, v);
+		_mm_store_si128(vd + 3, v);
+		vd += 4;
+		count -= 4;
+	}
+	while (count-- > 0)
+		_mm_store_si128(vd++, v);
+}
+
+__attribute__((target("sse2")))
+static void	copy_vectors(__m128i *vd, const __m128i *vs, size_t count)
+{
+	while (count >= 4)
+	{
+		_mm_store_si128(vd, _mm_loadu_si128(vs));
+		_mm_store_si128(vd + 1, _mm_loadu_si128(vs + 1));
+		_mm_store_si128(vd + 2, _mm_loadu_si128(vs + 2));
+		_mm_store_si128(vd + 3, _mm_loadu_si128(vs + 3));
+		vd += 4;
+		vs += 4;
+		count -= 4;
+	}
+	while (count-- > 0)
+		_mm_store_si128(vd++, _mm_loadu_si128(vs++));
+}
+
+/*
+** Unaligned head, aligned body, then an unaligned tail ending exactly at
+** b + len that may rewrite a few bytes of the body with the same value.
+*/
+__attribute__((target("sse2")))
+void	*sse2_memset_sa(void *b, int c, size_t len)
+{
+	unsigned char	*end;
+	__m128i			*vd;
+	__m128i			v;
+
+	if (len < sizeof(__m128i))
+		return (word_memset_sa(b, c, len));
+	end = (unsigned char *)b + len;
+	v = _mm_set1_epi8((char)c);
+	_mm_storeu_si128(b, v);
+	vd = next_vector(b);
+	set_vectors(vd, v, (end - (unsigned char *)vd) / sizeof(__m128i));
+	_mm_storeu_si128((__m128i *)end - 1, v);
+	return (b);
+}
+
+__attribute__((target("sse2")))
+void	*sse2_memcpy_sa(void *dst, const void *src, size_t n)
+{
+	const unsigned char	*s;
+	__m128i				*vd;
+	size_t				skip;
+
+	if (n < sizeof(__m128i))
+		return (word_memcpy_sa(dst, src, n));
+	s = src;
+	_mm_storeu_si128(dst, _mm_loadu_si128(src));
+	vd = next_vector(dst);
+	skip = (unsigned char *)vd - (unsigned char *)dst;
+	copy_vectors(vd, (const __m128i *)(s + skip),
+		(n - skip) / sizeof(__m128i));
+	_mm_storeu_si128((__m128i *)((unsigned char *)dst + n) - 1,
+		_mm_loadu_si128((const __m128i *)(s + n) - 1));
+	return (dst);
+}
+
+#endif
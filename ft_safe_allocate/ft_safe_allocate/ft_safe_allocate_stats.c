@@ -0,0 +1,85 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_stats.c                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 13:14:09 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 15:03:53 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+static t_counters	*counters_sa(void)
+{
+	static t_counters	counters;
+
+	return (&counters);
+}
+
+void	stats_add_sa(size_t count, size_t bytes)
+{
+	t_counters	*counters;
+	size_t		live;
+	size_t		peak;
+
+	counters = counters_sa();
+	atomic_fetch_add_explicit(
+		&counters->total_allocs, count, memory_order_relaxed);
+	live = atomic_fetch_add_explicit(
+			&counters->live_bytes, bytes, memory_order_relaxed) + bytes;
+	peak = atomic_load_explicit(&counters->peak_bytes, memory_order_relaxed);
+	while (live > peak)
+	{
+		if (atomic_compare_exchange_weak_explicit(&counters->peak_bytes,
+				&peak, live, memory_order_relaxed, memory_order_relaxed))
+			peak = live;
+	}
+}
+
+void	stats_remove_sa(size_t count, size_t bytes)
+{
+	t_counters	*counters;
+
+	counters = counters_sa();
+	atomic_fetch_add_explicit(
+		&counters->total_frees, count, memory_order_relaxed);
+	atomic_fetch_sub_explicit(
+		&counters->live_bytes, bytes, memory_order_relaxed);
+}
+
+/*
+** total_frees is read first: every free it counts was preceded by an
+** allocation already visible in total_allocs, so live_blocks cannot wrap.
+*/
+void	*get_stats(t_alloc_stats *stats)
+{
+	t_counters	*counters;
+
+	if (!stats)
+		return (NULL);
+	counters = counters_sa();
+	stats->total_frees = atomic_load_explicit(
+			&counters->total_frees, memory_order_acquire);
+	stats->total_allocs = atomic_load_explicit(
+			&counters->total_allocs, memory_order_acquire);
+	stats->live_bytes = atomic_load_explicit(
+			&counters->live_bytes, memory_order_relaxed);
+	stats->peak_bytes = atomic_load_explicit(
+			&counters->peak_bytes, memory_order_relaxed);
+	stats->dropped_diagnostics = atomic_load_explicit(
+			&diag_sa()->dropped, memory_order_relaxed);
+	stats->live_blocks = 0;
+	if (stats->total_allocs > stats->total_frees)
+		stats->live_blocks = stats->total_allocs - stats->total_frees;
+	return (stats);
+}
+
+size_t	get_allocation_count(t_tracker *tracker)
+{
+	(void)tracker;
+	return (atomic_load_explicit(
+			&counters_sa()->live_bytes, memory_order_relaxed));
+}
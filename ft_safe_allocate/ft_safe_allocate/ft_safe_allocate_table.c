@@ -0,0 +1,108 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_table.c                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 12:47:18 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 19:43:36 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+/*
+** Robin Hood keeps each probe chain ordered by distance from home, so the
+** walk ends at a gap, at an entry closer to its home than ptr would be, or
+** past the longest probe the array has seen.
+*/
+static t_allocation	*probe_find(
+	t_allocation *slots, size_t capacity, size_t bound, const void *ptr)
+{
+	size_t	pos;
+	size_t	dist;
+
+	if (!slots)
+		return (NULL);
+	pos = hash_ptr(ptr) & (capacity - 1);
+	dist = 0;
+	while (dist <= bound && slots[pos].user_ptr && slots[pos].user_ptr != ptr
+		&& probe_distance_sa(slots[pos].user_ptr, pos, capacity) >= dist)
+	{
+		pos = (pos + 1) & (capacity - 1);
+		dist++;
+	}
+	if (INSTRUMENT)
+		instr_probe_sa(INSTR_FIND, dist + 1);
+	if (dist <= bound && slots[pos].user_ptr == ptr)
+		return (&slots[pos]);
+	return (NULL);
+}
+
+t_allocation	*table_probe_sa(t_table *table, const void *ptr)
+{
+	t_allocation	*slot;
+	t_table			*old;
+
+	slot = probe_find(table->slots, table->capacity, table->max_probe, ptr);
+	old = table->old;
+	while (!slot && old)
+	{
+		slot = probe_find(old->slots, old->capacity, old->max_probe, ptr);
+		old = old->old;
+	}
+	return (slot);
+}
+
+t_allocation	*table_find_sa(t_table *table, const void *ptr)
+{
+	size_t	hint;
+
+	if (!ptr)
+		return (NULL);
+	hint = SIZE_MAX;
+	if (INLINE_HEADER)
+		hint = header_slot_sa(ptr);
+	if (hint < table->capacity && table->slots[hint].user_ptr == ptr)
+	{
+		if (INSTRUMENT)
+			instr_probe_sa(INSTR_FIND, 1);
+		return (&table->slots[hint]);
+	}
+	return (table_probe_sa(table, ptr));
+}
+
+int	table_insert_sa(t_table *table, const t_allocation *entry)
+{
+	size_t	longest;
+
+	table_migrate_sa(table, REHASH_STEP);
+	if ((table->count + table->pending + 1) * 100
+		> table->capacity * TABLE_MAX_LOAD)
+		table_grow_sa(table, 1);
+	if (table->count >= table->capacity)
+	{
+		diag_msg_sa(ERR_ALLOC_TRACK_LIMIT);
+		return (ERROR);
+	}
+	longest = table_place_sa(table->slots, table->capacity, entry);
+	if (longest > table->max_probe)
+		table->max_probe = longest;
+	table->count++;
+	return (SUCCESS);
+}
+
+void	table_remove_sa(t_table *table, t_allocation *slot)
+{
+	t_table	*owner;
+
+	owner = table;
+	while (slot < owner->slots || slot >= owner->slots + owner->capacity)
+		owner = owner->old;
+	owner->count--;
+	if (owner != table)
+		table->pending--;
+	table_shift_sa(owner->slots, owner->capacity, slot - owner->slots);
+	table_migrate_sa(table, REHASH_STEP);
+}
@@ -0,0 +1,67 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_tracker.c                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 12:48:36 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 18:38:04 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+#if !LOCK_FREE_TRACKING
+
+static t_tracker	*tracker_storage(void)
+{
+	static t_tracker	tracker;
+
+	return (&tracker);
+}
+
+static void	init_tracker(void)
+{
+	t_tracker	*tracker;
+	int			i;
+
+	tracker = tracker_storage();
+	i = 0;
+	while (i < SHARD_COUNT)
+	{
+		pthread_mutex_init(&tracker->shards[i].lock, NULL);
+		i++;
+	}
+	fork_handlers_sa();
+}
+
+t_tracker	*tracker_sa(void)
+{
+	static pthread_once_t	once = PTHREAD_ONCE_INIT;
+
+	pthread_once(&once, init_tracker);
+	return (tracker_storage());
+}
+
+t_shard	*shard_for_sa(t_tracker *tracker, const void *ptr)
+{
+	return (&tracker->shards[(hash_ptr(ptr) >> 48) & (SHARD_COUNT - 1)]);
+}
+
+int	tracker_insert_sa(t_tracker *tracker, const t_allocation *entry)
+{
+	t_shard	*shard;
+	int		status;
+
+	shard = shard_for_sa(tracker, entry->user_ptr);
+	if (!INSTRUMENT)
+		pthread_mutex_lock(&shard->lock);
+	else
+		instr_lock_sa(&shard->lock);
+	status = table_insert_sa(&shard->table, entry);
+	pthread_mutex_unlock(&shard->lock);
+	return (status);
+}
+
+#endif
@@ -0,0 +1,143 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_tracker_batch.c                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 14:05:42 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 15:26:15 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+#if !LOCK_FREE_TRACKING
+
+static int	insert_run(t_shard *shard, const t_allocation *entries,
+	t_batch_key *run, size_t m)
+{
+	size_t	i;
+	int		status;
+
+	if (!INSTRUMENT)
+		pthread_mutex_lock(&shard->lock);
+	else
+		instr_lock_sa(&shard->lock);
+	status = table_reserve_sa(&shard->table, m);
+	if (status == SUCCESS)
+		batch_sort_run_sa(&shard->table, entries, run, m);
+	i = 0;
+	while (status == SUCCESS && i < m)
+		status = table_insert_sa(&shard->table, &entries[run[i++].index]);
+	pthread_mutex_unlock(&shard->lock);
+	return (status);
+}
+
+static size_t	remove_run(t_shard *shard, t_allocation *entries,
+	t_batch_key *run, size_t m)
+{
+	t_allocation	*entry;
+	t_allocation	*slot;
+	size_t			removed;
+
+	removed = 0;
+	if (!INSTRUMENT)
+		pthread_mutex_lock(&shard->lock);
+	else
+		instr_lock_sa(&shard->lock);
+	batch_sort_run_sa(&shard->table, entries, run, m);
+	while (m-- > 0)
+	{
+		entry = &entries[(run++)->index];
+		slot = table_find_sa(&shard->table, entry->user_ptr);
+		entry->user_ptr = NULL;
+		if (slot)
+		{
+			*entry = *slot;
+			table_remove_sa(&shard->table, slot);
+			removed++;
+		}
+	}
+	pthread_mutex_unlock(&shard->lock);
+	return (removed);
+}
+
+/*
+** Without memory for the keys, fall back to one lookup per pointer.
+*/
+static size_t	remove_each(t_tracker *tracker, t_allocation *entries, size_t n)
+{
+	size_t	removed;
+	size_t	i;
+
+	removed = 0;
+	i = 0;
+	while (i < n)
+	{
+		if (untrack_sa(tracker, entries[i].user_ptr, &entries[i]) == SUCCESS)
+			removed++;
+		else
+			entries[i].user_ptr = NULL;
+		i++;
+	}
+	return (removed);
+}
+
+int	tracker_insert_batch_sa(
+	t_tracker *tracker, const t_allocation *entries, size_t n)
+{
+	t_batch_key	stack[BATCH_CHUNK];
+	t_batch_key	*keys;
+	size_t		i;
+	size_t		end;
+	int			status;
+
+	keys = batch_keys_sa(tracker, entries, n, stack);
+	if (!keys)
+		return (diag_msg_sa(ERR_MALLOC_FAILED), ERROR);
+	status = SUCCESS;
+	i = 0;
+	while (status == SUCCESS && i < n)
+	{
+		end = i;
+		while (end < n && keys[end].key == keys[i].key)
+			end++;
+		status = insert_run(&tracker->shards[keys[i].key],
+				entries, keys + i, end - i);
+		i = end;
+	}
+	if (keys != stack)
+		RAW_FREE(keys);
+	return (status);
+}
+
+size_t	tracker_remove_batch_sa(
+	t_tracker *tracker, t_allocation *entries, size_t n)
+{
+	t_batch_key	stack[BATCH_CHUNK];
+	t_batch_key	*keys;
+	size_t		i;
+	size_t		end;
+	size_t		removed;
+
+	keys = batch_keys_sa(tracker, entries, n, stack);
+	removed = 0;
+	i = 0;
+	while (keys && i < n)
+	{
+		end = i;
+		while (end < n && keys[end].key == keys[i].key)
+			end++;
+		removed += remove_run(&tracker->shards[keys[i].key],
+				entries, keys + i, end - i);
+		i = end;
+	}
+	if (!keys)
+		removed = remove_each(tracker, entries, n);
+	if (keys != stack)
+		RAW_FREE(keys);
+	return (removed);
+}
+
+#endif
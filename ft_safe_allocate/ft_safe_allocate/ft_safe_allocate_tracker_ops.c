@@ -0,0 +1,90 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_tracker_ops.c                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 12:50:34 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 18:38:04 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+#if !LOCK_FREE_TRACKING
+
+int	untrack_sa(t_tracker *tracker, const void *ptr, t_allocation *entry)
+{
+	t_shard			*shard;
+	t_allocation	*slot;
+
+	shard = shard_for_sa(tracker, ptr);
+	if (!INSTRUMENT)
+		pthread_mutex_lock(&shard->lock);
+	else
+		instr_lock_sa(&shard->lock);
+	slot = table_find_sa(&shard->table, ptr);
+	if (slot)
+	{
+		*entry = *slot;
+		table_remove_sa(&shard->table, slot);
+	}
+	pthread_mutex_unlock(&shard->lock);
+	if (!slot)
+		return (ERROR);
+	return (SUCCESS);
+}
+
+void	tracker_drain_sa(
+	t_tracker *tracker, void (*fn)(t_allocation *, void *), void *arg)
+{
+	t_table	table;
+	t_shard	*shard;
+	int		i;
+
+	i = 0;
+	while (i < SHARD_COUNT)
+	{
+		shard = &tracker->shards[i++];
+		if (!INSTRUMENT)
+			pthread_mutex_lock(&shard->lock);
+		else
+			instr_lock_sa(&shard->lock);
+		table = shard->table;
+		ft_memset_sa(&shard->table, 0, sizeof(t_table));
+		pthread_mutex_unlock(&shard->lock);
+		table_foreach_sa(&table, fn, arg);
+		table_release_sa(&table);
+	}
+}
+
+void	tracker_foreach_sa(
+	t_tracker *tracker, void (*fn)(t_allocation *, void *), void *arg)
+{
+	t_shard	*shard;
+	int		i;
+
+	i = 0;
+	while (i < SHARD_COUNT)
+	{
+		shard = &tracker->shards[i++];
+		if (!INSTRUMENT)
+			pthread_mutex_lock(&shard->lock);
+		else
+			instr_lock_sa(&shard->lock);
+		table_foreach_sa(&shard->table, fn, arg);
+		pthread_mutex_unlock(&shard->lock);
+	}
+}
+
+void	tracker_locks_sa(t_tracker *tracker, int (*op)(pthread_mutex_t *))
+{
+	int	i;
+
+	i = 0;
+	while (i < SHARD_COUNT)
+		op(&tracker->shards[i++].lock);
+}
+
+#endif
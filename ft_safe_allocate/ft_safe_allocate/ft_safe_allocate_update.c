@@ -0,0 +1,103 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_update.c                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 13:28:35 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 19:43:36 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+#if !LOCK_FREE_TRACKING
+
+/*
+** fn runs with the shard locked and keeps the key, so the entry stays in
+** its slot.
+*/
+int	tracker_update_sa(t_tracker *tracker, const void *ptr,
+	void (*fn)(t_allocation *, void *), void *arg)
+{
+	t_shard			*shard;
+	t_allocation	*slot;
+
+	shard = shard_for_sa(tracker, ptr);
+	if (!INSTRUMENT)
+		pthread_mutex_lock(&shard->lock);
+	else
+		instr_lock_sa(&shard->lock);
+	slot = table_find_sa(&shard->table, ptr);
+	if (slot)
+		fn(slot, arg);
+	pthread_mutex_unlock(&shard->lock);
+	if (!slot)
+		return (ERROR);
+	return (SUCCESS);
+}
+
+/*
+** A parked entry has no original_ptr, like an ADD_TO_TRACK block, so the
+** scrubber and the slot hint updates leave its block alone while it is
+** resized, and maybe freed, without the lock.
+*/
+int	tracker_park_sa(t_tracker *tracker, const void *ptr,
+	t_allocation *entry, t_lf_slot **claimed)
+{
+	t_shard			*shard;
+	t_allocation	*slot;
+
+	*claimed = NULL;
+	shard = shard_for_sa(tracker, ptr);
+	if (!INSTRUMENT)
+		pthread_mutex_lock(&shard->lock);
+	else
+		instr_lock_sa(&shard->lock);
+	slot = table_find_sa(&shard->table, ptr);
+	if (slot)
+	{
+		*entry = *slot;
+		slot->original_ptr = NULL;
+	}
+	pthread_mutex_unlock(&shard->lock);
+	if (!slot)
+		return (ERROR);
+	return (SUCCESS);
+}
+
+#else
+
+/*
+** fn runs while the slot is claimed; the key is published again after.
+*/
+int	tracker_update_sa(t_tracker *tracker, const void *ptr,
+	void (*fn)(t_allocation *, void *), void *arg)
+{
+	t_lf_slot		*slot;
+
+	slot = lf_claim_sa(tracker, ptr);
+	if (!slot)
+		return (lf_spill_update_sa(tracker, ptr, fn, arg));
+	fn(&slot->entry, arg);
+	atomic_store_explicit(&slot->key, (void *)ptr, memory_order_release);
+	return (SUCCESS);
+}
+
+/*
+** The slot stays claimed until tracker_rekey_sa(), so walks skip it.
+** Entries spilled to the overflow table are not parked; REALLOC copies
+** them.
+*/
+int	tracker_park_sa(t_tracker *tracker, const void *ptr,
+	t_allocation *entry, t_lf_slot **claimed)
+{
+	*claimed = lf_claim_sa(tracker, ptr);
+	if (!*claimed)
+		return (ERROR);
+	*entry = (*claimed)->entry;
+	return (SUCCESS);
+}
+
+#endif
@@ -6,7 +6,7 @@
 /*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/10/21 16:25:38 by mait-you          #+#    #+#             */
-/*   Updated: 2025/05/04 11:48:15 by mait-you         ###   ########.fr       */
+/*   Updated: 2026/10/17 15:03:53 by mait-you         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -14,12 +14,9 @@
 
 void	*ft_memset_sa(void *b, int c, size_t len)
 {
-	unsigned char	*ptr;
-
-	ptr = (unsigned char *)b;
-	while (len-- > 0)
-		*(ptr++) = (unsigned char)c;
-	return (b);
+	if (len < MEMOPS_VECTOR_MIN)
+		return (word_memset_sa(b, c, len));
+	return (memops_sa()->set(b, c, len));
 }
 
 void	*ft_calloc_sa(size_t count, size_t size)
@@ -28,7 +25,7 @@ void	*ft_calloc_sa(size_t count, size_t size)
 
 	if (size != 0 && count > SIZE_MAX / size)
 		return (NULL);
-	ptr = malloc(count * size);
+	ptr = RAW_MALLOC(count * size);
 	if (!ptr)
 		return (NULL);
 	ft_memset_sa(ptr, 0, count * size);
@@ -37,37 +34,30 @@ void	*ft_calloc_sa(size_t count, size_t size)
 
 void	*ft_memcpy_sa(void *dst, const void *src, size_t n)
 {
-	size_t			i;
-	char			*ptr;
-
 	if (!src && !dst)
 		return (0);
-	i = 0;
-	ptr = (char *)dst;
-	while (i < n)
-	{
-		*(ptr++) = *((const char *)src++);
-		i++;
-	}
-	return (dst);
+	if (n < MEMOPS_VECTOR_MIN)
+		return (word_memcpy_sa(dst, src, n));
+	return (memops_sa()->copy(dst, src, n));
 }
 
 void	ft_putstr_fd_sa(char *s, int fd)
 {
+	size_t	len;
+
 	if (!s || fd == -1)
 		return ;
-	while (*s)
-		write(fd, s++, 1);
+	len = 0;
+	while (s[len])
+		len++;
+	write(fd, s, len);
 }
 
 void	ft_puthex_fd_sa(unsigned long n, int fd)
 {
-	char	*b;
+	char	line[sizeof(unsigned long) * 2];
 
-	b = "0123456789abcdef";
 	if (fd == -1)
 		return ;
-	if (n >= 16)
-		ft_puthex_fd_sa(n / 16, fd);
-	write(fd, &b[n % 16], 1);
+	write(fd, line, diag_num_sa(line, 0, n, 16));
 }
@@ -0,0 +1,60 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_safe_allocate_word.c                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 13:57:32 by mait-you          #+#    #+#             */
+/*   Updated: 2026/10/17 13:57:32 by mait-you         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/ft_safe_allocate.h"
+
+void	*word_memset_sa(void *b, int c, size_t len)
+{
+	unsigned char	*ptr;
+	t_word			pattern;
+
+	ptr = b;
+	pattern = (t_word)(unsigned char)c * 0x0101010101010101ULL;
+	while (len > 0 && ((uintptr_t)ptr & (sizeof(t_word) - 1)))
+	{
+		*(ptr++) = (unsigned char)c;
+		len--;
+	}
+	while (len >= sizeof(t_word))
+	{
+		*(t_word *)ptr = pattern;
+		ptr += sizeof(t_word);
+		len -= sizeof(t_word);
+	}
+	while (len-- > 0)
+		*(ptr++) = (unsigned char)c;
+	return (b);
+}
+
+void	*word_memcpy_sa(void *dst, const void *src, size_t n)
+{
+	unsigned char		*d;
+	const unsigned char	*s;
+
+	d = dst;
+	s = src;
+	while (n > 0 && ((uintptr_t)d & (sizeof(t_word) - 1)))
+	{
+		*(d++) = *(s++);
+		n--;
+	}
+	while (n >= sizeof(t_word))
+	{
+		*(t_word *)d = *(const t_word *)s;
+		d += sizeof(t_word);
+		s += sizeof(t_word);
+		n -= sizeof(t_word);
+	}
+	while (n-- > 0)
+		*(d++) = *(s++);
+	return (dst);
+}
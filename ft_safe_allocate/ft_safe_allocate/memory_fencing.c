@@ -6,83 +6,69 @@
 /*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/04/18 18:46:19 by mait-you          #+#    #+#             */
-/*   Updated: 2025/05/05 10:09:52 by mait-you         ###   ########.fr       */
+/*   Updated: 2026/10/17 17:09:28 by mait-you         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "../include/ft_safe_allocate.h"
 
 int	add_to_tracking(
-	t_allocation *ptr_array, void *original_ptr, void *user_ptr, size_t *size)
+	t_tracker *tracker, void *original_ptr, void *user_ptr, size_t *size)
 {
-	size_t	hash;
-	int		i;
-	size_t	start_hash;
+	t_allocation	entry;
 
-	i = 0;
-	hash = hash_ptr(user_ptr);
-	start_hash = hash;
-	while (i < HASH_TABLE_SIZE)
-	{
-		if (ptr_array[hash].user_ptr == NULL)
-		{
-			ptr_array[hash].original_ptr = original_ptr;
-			ptr_array[hash].user_ptr = user_ptr;
-			if (size)
-				ptr_array[hash].size = size[0] * size[1];
-			return (SUCCESS);
-		}
-		hash = (hash + 1) % HASH_TABLE_SIZE;
-		i++;
-		if (hash == start_hash)
-			break;
-	}
-	ft_putstr_fd_sa(ERR_ALLOC_TRACK_LIMIT, STDERR_FILENO);
-	return (ERROR);
+	entry.original_ptr = original_ptr;
+	entry.user_ptr = user_ptr;
+	entry.size = 0;
+	if (size)
+		entry.size = size[0] * size[1];
+	if (ALLOC_SITES || HEAP_PROFILE)
+		site_tag_sa(&entry);
+	if (FENCE_SCRUB)
+		scrub_stamp_sa(&entry, scrub_now_sa());
+	return (track_sa(tracker, &entry));
 }
 
+/*
+** ptr is the front guard. The end guard is the first GUARD_SIZE-aligned
+** word at or after the user data; the padding bytes in between get the
+** canary bytes end_intact_sa() expects there.
+*/
 void	*setup_memfen(void *ptr, size_t total_size)
 {
+	unsigned char	*user;
+	unsigned char	*end;
+	uint64_t		canary;
+	size_t			pad;
+
 	if (!ptr)
 		return (NULL);
-	ft_memset_sa(ptr, GUARD_PATTERN, GUARD_SIZE);
-	ft_memset_sa(
-		(unsigned char *)ptr + GUARD_SIZE + total_size,
-		GUARD_PATTERN,
-		GUARD_SIZE);
-	return ((unsigned char *)ptr + GUARD_SIZE);
-}
-
-static int	check_guard(
-	unsigned char *guard, void *user_ptr, const char *error_msg)
-{
-	int	i;
-
-	i = 0;
-	while (i < GUARD_SIZE)
-	{
-		if (guard[i] != GUARD_PATTERN)
-		{
-			ft_putstr_fd_sa((char *)error_msg, STDERR_FILENO);
-			ft_puthex_fd_sa((unsigned long)user_ptr, STDERR_FILENO);
-			write(STDERR_FILENO, "\n", 1);
-			return (ERROR);
-		}
-		i++;
-	}
-	return (SUCCESS);
+	user = (unsigned char *)ptr + GUARD_SIZE;
+	*(t_word *)ptr = canary_sa(ptr);
+	end = end_guard_sa(user, total_size);
+	canary = canary_sa(end);
+	*(t_word *)end = canary;
+	pad = end - (user + total_size);
+	ft_memcpy_sa(end - pad, (unsigned char *)&canary + GUARD_SIZE - pad, pad);
+	return (user);
 }
 
 int	check_memfen(void *user_ptr, size_t total_size)
 {
-	unsigned char	*start_guard;
-	unsigned char	*end_guard;
+	uint64_t	start;
+	int			status;
 
-	start_guard = (unsigned char *)user_ptr - GUARD_SIZE;
-	end_guard = (unsigned char *)user_ptr + total_size;
-	if (check_guard(start_guard, user_ptr, ERR_CORRUPTION_START) == ERROR)
-		return (ERROR);
-	if (check_guard(end_guard, user_ptr, ERR_CORRUPTION_END) == ERROR)
-		return (ERROR);
-	return (SUCCESS);
+	start = 0;
+	if (INSTRUMENT)
+		start = instr_clock_sa();
+	status = ERROR;
+	if (!start_intact_sa(user_ptr))
+		diag_ptr_sa(ERR_CORRUPTION_START, user_ptr, "\n");
+	else if (!end_intact_sa(user_ptr, total_size))
+		diag_ptr_sa(ERR_CORRUPTION_END, user_ptr, "\n");
+	else
+		status = SUCCESS;
+	if (INSTRUMENT)
+		instr_fence_sa(instr_clock_sa() - start);
+	return (status);
 }
@@ -6,7 +6,7 @@
 /*   By: mait-you <mait-you@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/04/18 18:44:47 by mait-you          #+#    #+#             */
-/*   Updated: 2025/05/06 14:22:36 by mait-you         ###   ########.fr       */
+/*   Updated: 2026/10/17 19:53:32 by mait-you         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -16,8 +16,19 @@
 /* Standard library includes */
 # include <unistd.h>
 # include <stdlib.h>
+# include <stddef.h>
+# include <stdint.h>
+# include <stdatomic.h>
+# include <sched.h>
 # include <pthread.h>
 # include <stdbool.h>
+# include <sys/mman.h>
+# include <sys/uio.h>
+# include <sys/random.h>
+# include <fcntl.h>
+# include <time.h>
+# include <execinfo.h>
+# include <errno.h>
 
 /* ************************************************************************** */
 /* 							Configuration Parameters                          */
@@ -32,16 +43,394 @@
 # endif
 
 /**
- * @brief Size of the hash table for tracking allocations
- * Larger values reduce collision probability but increase memory usage
+ * @brief Store a t_header (size, slot hint, magic) in front of every block
+ * FREE_ONE and REALLOC validate the magic and jump to the hinted slot
+ * instead of probing, and reject foreign pointers without a lookup.
+ * ADD_TO_TRACK copies external blocks into a block with a header.
+ */
+# ifndef INLINE_HEADER
+#  define INLINE_HEADER false
+# endif
+
+/**
+ * @brief Build the LD_PRELOAD object that replaces malloc and friends
+ * Set by the preload Makefile target. The library's own allocations then
+ * go to glibc's __libc_* entry points through the RAW_* macros. Allocator
+ * calls made while the thread is already inside the tracker bypass it
+ * too. The interposed free() also accepts pointers it did not track, so
+ * it cannot read in front of them, which rules out INLINE_HEADER.
+ */
+# ifndef PRELOAD
+#  define PRELOAD false
+# endif
+# if PRELOAD && INLINE_HEADER
+#  error "PRELOAD does not support INLINE_HEADER"
+# endif
+
+/**
+ * @brief Track allocations in a lock-free table instead of locked shards
+ * Slots are claimed by compare-and-swap on user_ptr and released with a
+ * tombstone, so no thread ever waits for FREE_ALL.
+ * The table has a fixed size (LOCKFREE_TABLE_SIZE) in this mode; blocks
+ * that find no slot within LOCKFREE_MAX_PROBE go to a locked overflow
+ * table.
+ */
+# ifndef LOCK_FREE_TRACKING
+#  define LOCK_FREE_TRACKING false
+# endif
+
+/**
+ * @brief Number of slots in the lock-free tracking table
+ * Used when LOCK_FREE_TRACKING is enabled. Must be a power of two.
+ */
+# ifndef LOCKFREE_TABLE_SIZE
+#  define LOCKFREE_TABLE_SIZE 65536
+# endif
+
+/**
+ * @brief Longest probe of the lock-free table
+ * Lookups never probe further than the longest insert so far, which is at
+ * most this, so misses stay short however many tombstones there are
+ */
+# ifndef LOCKFREE_MAX_PROBE
+#  define LOCKFREE_MAX_PROBE 256
+# endif
+
+/**
+ * @brief Initial size of the hash table for tracking allocations
+ * The table doubles when it fills past TABLE_MAX_LOAD, so this only sets
+ * the memory used before the first growth. Must be a power of two.
  */
 # define HASH_TABLE_SIZE 2048
 
+/**
+ * @brief Load factor (in percent) at which the tracking table grows
+ * Robin Hood placement keeps probes short up to about 90
+ */
+# ifndef TABLE_MAX_LOAD
+#  define TABLE_MAX_LOAD 75
+# endif
+
+/**
+ * @brief Number of old slots moved to the new table per tracker call
+ * While a growth is in progress every insert/remove migrates this many
+ * slots, so no single call pays for the whole rehash
+ */
+# ifndef REHASH_STEP
+#  define REHASH_STEP 64
+# endif
+
+/**
+ * @brief Number of independently locked tracking shards
+ * Pointers are spread over the shards by hash_ptr(), so operations on
+ * different pointers rarely wait on each other. Must be a power of two
+ * no larger than BATCH_RADIX; 1 gives the old single-lock behaviour.
+ */
+# ifndef SHARD_COUNT
+#  define SHARD_COUNT 16
+# endif
+
+/**
+ * @brief Initial size of each shard's table
+ * The shards split HASH_TABLE_SIZE between them, so a program with few
+ * live blocks keeps about the tracker memory of a single table
+ */
+# if HASH_TABLE_SIZE / SHARD_COUNT > 16
+#  define SHARD_TABLE_SIZE (HASH_TABLE_SIZE / SHARD_COUNT)
+# else
+#  define SHARD_TABLE_SIZE 16
+# endif
+
+/**
+ * @brief Keep a per-thread magazine in front of the shared tracker
+ * Each thread records its new allocations locally and merges them into
+ * the shared table MAGAZINE_SIZE at a time; frees of blocks still in the
+ * magazine never touch the shared table. Freed small blocks are kept for
+ * reuse by the same thread.
+ */
+# ifndef THREAD_MAGAZINES
+#  define THREAD_MAGAZINES false
+# endif
+
+/**
+ * @brief Allocations a thread records before merging them into the tracker
+ * Split in a young and an old half; see magazine_insert_sa(). Must be a
+ * power of two, at least 16.
+ */
+# ifndef MAGAZINE_SIZE
+#  define MAGAZINE_SIZE 256
+# endif
+
+/**
+ * @brief Freed blocks a thread keeps for reuse, and the largest one kept
+ * MAGAZINE_MAX_BLOCK counts guard bytes when MEMORY_FENCING is enabled
+ */
+# ifndef MAGAZINE_CACHE
+#  define MAGAZINE_CACHE 16
+# endif
+# ifndef MAGAZINE_MAX_BLOCK
+#  define MAGAZINE_MAX_BLOCK 1024
+# endif
+
+/**
+ * @brief Serve small blocks from per-size-class slabs instead of malloc
+ * Blocks of up to SLAB_MAX_BLOCK bytes (guards and header included) are
+ * rounded up to a multiple of SLAB_ALIGN and carved back to back from
+ * SLAB_SIZE slabs obtained with mmap. Freed blocks go to a per-class free
+ * list and are reused; slabs are kept until the process exits.
+ */
+# ifndef SLAB_ALLOCATOR
+#  define SLAB_ALLOCATOR false
+# endif
+
+/**
+ * @brief Slab geometry
+ * SLAB_SIZE must be a multiple of the page size, SLAB_MAX_BLOCK a
+ * multiple of SLAB_ALIGN; there is one class per SLAB_ALIGN step.
+ */
+# ifndef SLAB_SIZE
+#  define SLAB_SIZE 65536
+# endif
+# ifndef SLAB_MAX_BLOCK
+#  define SLAB_MAX_BLOCK 512
+# endif
+# define SLAB_ALIGN 16
+# define SLAB_CLASSES (SLAB_MAX_BLOCK / SLAB_ALIGN)
+
+/**
+ * @brief Blocks of at least MMAP_MIN_BLOCK bytes (overhead included) get
+ * an anonymous mapping of their own
+ * The kernel zeroes the pages, so zeroed allocations skip the memset and
+ * pages are only backed once written. Must stay above SLAB_MAX_BLOCK and
+ * MAGAZINE_MAX_BLOCK.
+ */
+# ifndef MMAP_MIN_BLOCK
+#  define MMAP_MIN_BLOCK 131072
+# endif
+
+/**
+ * @brief Put large fenced blocks between two PROT_NONE pages
+ * Only used with MEMORY_FENCING. Blocks of at least PAGE_GUARD_MIN bytes
+ * (overhead included) end less than PAGE_GUARD_ALIGN bytes before an
+ * inaccessible page, so an overflow faults on the offending access
+ * instead of being found by check_memfen() at free time. Smaller blocks
+ * keep their canaries. PAGE_GUARD_MIN must stay above
+ * SLAB_MAX_BLOCK.
+ */
+# ifndef PAGE_GUARDS
+#  define PAGE_GUARDS false
+# endif
+# ifndef PAGE_GUARD_MIN
+#  define PAGE_GUARD_MIN 65536
+# endif
+# define PAGE_GUARD_ALIGN 16
+
+/**
+ * @brief Check the guards of live blocks from a background thread
+ * Only used with MEMORY_FENCING. The first fenced block starts a thread
+ * that wakes up every SCRUB_PERIOD_MS and checks tracked blocks for about
+ * SCRUB_SLICE_US microseconds, SCRUB_STEP tracker slots per lock hold,
+ * resuming where it stopped. Each corrupted block is reported once, with
+ * the time since its guards were last found intact.
+ */
+# ifndef FENCE_SCRUB
+#  define FENCE_SCRUB false
+# endif
+# ifndef SCRUB_PERIOD_MS
+#  define SCRUB_PERIOD_MS 50
+# endif
+# ifndef SCRUB_SLICE_US
+#  define SCRUB_SLICE_US 200
+# endif
+# ifndef SCRUB_STEP
+#  define SCRUB_STEP 64
+# endif
+# define SCRUB_BAD UINT64_MAX
+
+/**
+ * @brief Size of the chunks arena blocks are bump-allocated from
+ * Larger blocks get a chunk of their own
+ */
+# ifndef ARENA_CHUNK_SIZE
+#  define ARENA_CHUNK_SIZE 65536
+# endif
+
+/**
+ * @brief Layout of an arena block: [size][front guard][user][end guard]
+ * The size word and guards are only present when MEMORY_FENCING is
+ * enabled; every block starts on an ARENA_ALIGN boundary.
+ */
+# define ARENA_ALIGN 16
+# define ARENA_PREFIX (MEMORY_FENCING * (sizeof(size_t) + GUARD_SIZE))
+# define ARENA_OVERHEAD (ARENA_PREFIX + MEMORY_FENCING * GUARD_TAIL)
+
+/**
+ * @brief Use SSE2/AVX2 versions of ft_memset_sa() and ft_memcpy_sa()
+ * The widest version the CPU supports is picked at the first call; other
+ * targets, or SIMD_MEMOPS=false, use the word-wide scalar versions.
+ * Shorter lengths than MEMOPS_VECTOR_MIN skip the dispatch altogether.
+ */
+# ifndef SIMD_MEMOPS
+#  if defined(__x86_64__) || defined(__i386__)
+#   define SIMD_MEMOPS true
+#  else
+#   define SIMD_MEMOPS false
+#  endif
+# endif
+# define MEMOPS_VECTOR_MIN 64
+
+/**
+ * @brief Buffered diagnostics
+ * Warnings and errors are formatted into one of DIAG_SLOTS lines of
+ * DIAG_LINE bytes (longer messages are cut) instead of being written byte
+ * by byte. A flusher thread, started by the first message and stopped
+ * after DIAG_IDLE_TICKS quiet periods of DIAG_FLUSH_MS, writes the ring
+ * with one writev(); whatever is left is written at exit. With
+ * DIAG_FLUSH_THREAD=false lines are only written at exit. A message that
+ * finds the ring full is dropped and counted rather than waiting.
+ * DIAG_SLOTS must be a power of two no larger than IOV_MAX.
+ */
+# ifndef DIAG_FD
+#  define DIAG_FD STDERR_FILENO
+# endif
+# ifndef DIAG_SLOTS
+#  define DIAG_SLOTS 64
+# endif
+# ifndef DIAG_LINE
+#  define DIAG_LINE 256
+# endif
+# ifndef DIAG_FLUSH_THREAD
+#  define DIAG_FLUSH_THREAD true
+# endif
+# ifndef DIAG_FLUSH_MS
+#  define DIAG_FLUSH_MS 20
+# endif
+# define DIAG_IDLE_TICKS 50
+
+/**
+ * @brief Instrumentation build
+ * Records a latency histogram per action, shard lock acquisitions and the
+ * time spent waiting for them, probe lengths and the time spent checking
+ * guard bytes. GET_PROFILE returns the counters and a summary is written
+ * at exit. Every probe sits behind if (INSTRUMENT), so the default build
+ * contains none of them. Latencies are read from the TSC on x86 and are in
+ * nanoseconds elsewhere; histogram bucket b counts latencies below 2^(b+1).
+ */
+# ifndef INSTRUMENT
+#  define INSTRUMENT false
+# endif
+# define INSTR_BUCKETS 32
+# define INSTR_PROBES 16
+# define INSTR_FIND 0
+# define INSTR_PLACE 1
+# if defined(__x86_64__) || defined(__i386__)
+#  define INSTR_UNIT "cycles"
+# else
+#  define INSTR_UNIT "ns"
+# endif
+
+/**
+ * @brief Record the call site of every tracked block
+ * ft_safe_allocate() notes its return address, and each block keeps the
+ * index of that site in a table of SITE_SLOTS interned sites. Blocks from
+ * the same site share one entry, whose live and total counters GET_SITES
+ * reads without a lock. Once the table is full, new sites are counted
+ * under the NULL site. SITE_SLOTS must be a power of two.
+ */
+# ifndef ALLOC_SITES
+#  define ALLOC_SITES false
+# endif
+# ifndef SITE_SLOTS
+#  define SITE_SLOTS 4096
+# endif
+
+/**
+ * @brief Sample allocations into a heap profile pprof can read
+ * Each thread counts down the bytes it allocates through ALLOCATE and
+ * ALLOCATE_UNINIT; the allocation that crosses zero has its stack recorded,
+ * and the next countdown is drawn from an exponential distribution of mean
+ * HEAP_SAMPLE_RATE bytes (SAMPLE_RATE changes it, 0 stops sampling). Up to
+ * HEAP_DEPTH frames are kept, in a table of HEAP_BUCKETS distinct stacks
+ * (a power of two); stacks that do not fit are counted together.
+ */
+# ifndef HEAP_PROFILE
+#  define HEAP_PROFILE false
+# endif
+# ifndef HEAP_SAMPLE_RATE
+#  define HEAP_SAMPLE_RATE 524288
+# endif
+# ifndef HEAP_DEPTH
+#  define HEAP_DEPTH 32
+# endif
+# ifndef HEAP_BUCKETS
+#  define HEAP_BUCKETS 4096
+# endif
+# ifndef HEAP_SKIP_MAX
+#  define HEAP_SKIP_MAX 16
+# endif
+
+/**
+ * @brief Leak report formats and sizes
+ * LEAK_TEXT is meant to be read, LEAK_CSV to be parsed. Blocks are grouped
+ * in a table of at least LEAK_GROUPS groups. Reports are written OUT_BUFFER
+ * bytes at a time.
+ */
+# define LEAK_TEXT 0
+# define LEAK_CSV 1
+# define LEAK_GROUPS 256
+# define OUT_BUFFER 4096
+
+/**
+ * @brief Batches of up to BATCH_CHUNK entries are sorted on the stack,
+ * larger ones in one temporary array
+ */
+# define BATCH_CHUNK 64
+
+/**
+ * @brief Digits of the radix pass that orders a batch by shard and bucket
+ */
+# define BATCH_RADIX 256
+
+/**
+ * @brief Marker left in a lock-free slot key when the slot is released
+ * Keeps probe chains intact so lookups can stop at the first empty slot
+ */
+# define SLOT_TOMBSTONE ((void *)~(uintptr_t)0)
+
+/**
+ * @brief Low bit set on a lock-free slot key while one thread owns the slot
+ * Allocations are at least 2-byte aligned, so the bit is never part of a
+ * real pointer. Lookups that meet their own pointer with this bit set
+ * yield until the owner publishes the slot again.
+ */
+# define SLOT_BUSY_BIT 1
+
 /**
  * @brief Size of guard regions in bytes
- * Used when MEMORY_FENCING is enabled
+ * Used when MEMORY_FENCING is enabled. Each guard is one word holding a
+ * canary derived from a per-process secret and the guard's address.
+ * The end guard is aligned, so up to GUARD_SIZE - 1 padding bytes sit
+ * between it and the user data: GUARD_TAIL covers both.
  */
 # define GUARD_SIZE 8
+# define GUARD_TAIL (2 * GUARD_SIZE - 1)
+
+/**
+ * @brief Value mixed with the user pointer in t_header.magic
+ */
+# define HEADER_MAGIC 0x5AFEA110C8ED5AFEULL
+
+/**
+ * @brief Bytes in front of the user pointer, and in total, around a block
+ * Layout: [t_header][gap][front guard][user data][padding][end guard],
+ * each part only present when INLINE_HEADER / MEMORY_FENCING is enabled.
+ * The gap rounds BLOCK_PREFIX up to BLOCK_ALIGN, so that user pointers
+ * keep the alignment of the block, which is at least BLOCK_ALIGN.
+ */
+# define BLOCK_ALIGN _Alignof(max_align_t)
+# define BLOCK_PREFIX ((INLINE_HEADER * sizeof(t_header) \
+	+ MEMORY_FENCING * GUARD_SIZE + BLOCK_ALIGN - 1) & ~(BLOCK_ALIGN - 1))
+# define BLOCK_OVERHEAD (BLOCK_PREFIX + MEMORY_FENCING * GUARD_TAIL)
 
 /**
  * @brief Terminal prompt definition that displays "program ▸" with color formatting
@@ -51,12 +440,6 @@
  */
 #define PROMPT "\e[1;31mprogram \e[1;32m▸ \e[0m"
 
-/**
- * @brief Pattern used for guard bytes
- * Used to detect buffer overflow/underflow
- */
-# define GUARD_PATTERN 0xAB
-
 /* ************************************************************************** */
 /* 							Status Codes and Messages                         */
 /* ************************************************************************** */
@@ -70,15 +453,20 @@
 /**
  * @brief Warning messages
  */
-# define WARN_NEAR_ALLOC_LIMIT "\033[33mWarning: \033[0mnearing allocation \
-limit\n"
+# define WARN_LOCKFREE_SPILL "\033[33mWarning: \033[0mlock-free table \
+full, further blocks are tracked under a lock\n"
 # define WARN_BOTH_PTR "\033[33mWarning: \033[0mBoth ptr and double_ptr \
 provided. Only ptr will be freed.\n"
+# define WARN_BAD_ALIGNMENT "\033[33mWarning: \033[0malignment must be a \
+power of two no larger than a page\n"
 # define WARN_FREE_NULL_PTR "\033[33mWarning: \033[0mattempt to free a NULL \
 pointer\n"
 # define WARN_PTR_NOT_ALLOCATED_1 "\033[33mWarning: \033[0m [0x "
 # define WARN_PTR_NOT_ALLOCATED_2 "] was not allocated by ft_safe_allocate \
 so it cannot be freed using it\n"
+# define WARN_DIAG_DROPPED_1 "\033[33mWarning: \033[0m"
+# define INSTR_PREFIX "\033[36mProfile: \033[0m"
+# define WARN_DIAG_DROPPED_2 " diagnostics dropped, the ring was full\n"
 
 /**
  * @brief Error messages
@@ -89,7 +477,15 @@ limit reached\n"
 detected at START  guard byte of: 0x"
 # define ERR_CORRUPTION_END "\033[31mError: \033[0mmemory corruption \
 detected at END guard byte of: 0x"
+# define ERR_SCRUB_AGE ", last verified "
+# define ERR_SCRUB_AGE_UNIT " ms ago\n"
 # define ERR_MALLOC_FAILED "\033[31mError: \033[0mmemory allocation failed\n"
+# define ERR_DIAG_TARGET "\033[31mError: \033[0mcannot open the diagnostics \
+file\n"
+# define ERR_LEAK_TARGET "\033[31mError: \033[0mcannot open the leak report \
+file\n"
+# define ERR_HEAP_TARGET "\033[31mError: \033[0mcannot open the heap profile \
+file\n"
 
 /* ************************************************************************** */
 /* 							Data Structures                                   */
@@ -99,15 +495,85 @@ detected at END guard byte of: 0x"
  * @brief Forward declarations
  */
 typedef struct s_allocation		t_allocation;
+typedef struct s_table			t_table;
+typedef struct s_shard			t_shard;
+typedef struct s_tracker		t_tracker;
+typedef struct s_lf_slot		t_lf_slot;
+typedef struct s_magazine		t_magazine;
+typedef struct s_registry		t_registry;
+typedef struct s_alloc_stats	t_alloc_stats;
+typedef struct s_counters		t_counters;
+typedef struct s_header			t_header;
+typedef struct s_slab_class		t_slab_class;
+typedef struct s_arena			t_arena;
+typedef struct s_arena_chunk	t_arena_chunk;
+typedef struct s_resize			t_resize;
+typedef struct s_memops			t_memops;
+typedef struct s_batch_key		t_batch_key;
+typedef struct s_diag_slot		t_diag_slot;
+typedef struct s_diag			t_diag;
+typedef struct s_profile		t_profile;
+typedef struct s_instr			t_instr;
+typedef struct s_site			t_site;
+typedef struct s_sites			t_sites;
+typedef struct s_site_stats		t_site_stats;
+typedef struct s_leak			t_leak;
+typedef struct s_leak_group		t_leak_group;
+typedef struct s_leak_groups	t_leak_groups;
+typedef struct s_out			t_out;
+typedef struct s_sampler		t_sampler;
+typedef struct s_heap_bucket	t_heap_bucket;
+typedef struct s_heap			t_heap;
+typedef struct s_scrub			t_scrub;
 typedef enum e_action			t_action;
 
+/**
+ * @brief Machine word used by the word-wide memset/memcpy
+ * may_alias lets it access any object, aligned(1) any address.
+ */
+typedef uint64_t				t_word __attribute__((may_alias, aligned(1)));
+
 /**
  * @brief Structure to track memory allocations
  * 
  * @param original_ptr	Original allocated pointer (before guard bytes)
  * @param user_ptr		Pointer provided to user (after guard bytes)
  * @param size			Size of allocated memory (user portion only)
+ * @param site			Index of the allocating site (ALLOC_SITES only),
+ *						only accessed through site_tag_sa() and site_of_sa()
+ * @param sample		Heap profile bucket of a sampled block, plus one
+ *						(HEAP_PROFILE only), only accessed through
+ *						sample_mark_sa() and sample_of_sa()
+ * @param verified		When the guards were last found intact, in ms, or
+ *						SCRUB_BAD once reported (FENCE_SCRUB only), only
+ *						accessed through scrub_stamp_sa() and
+ *						scrub_stamp_of_sa()
  */
+# if FENCE_SCRUB
+
+struct s_allocation
+{
+	void		*original_ptr;
+	void		*user_ptr;
+	size_t		size;
+	uint32_t	site;
+	uint32_t	sample;
+	uint64_t	verified;
+};
+
+# elif ALLOC_SITES || HEAP_PROFILE
+
+struct s_allocation
+{
+	void		*original_ptr;
+	void		*user_ptr;
+	size_t		size;
+	uint32_t	site;
+	uint32_t	sample;
+};
+
+# else
+
 struct s_allocation
 {
 	void	*original_ptr;
@@ -115,164 +581,1772 @@ struct s_allocation
 	size_t	size;
 };
 
+# endif
+
 /**
- * @brief Action enum for ft_safe_allocate function
+ * @brief Metadata stored in front of a block when INLINE_HEADER is enabled
+ *
+ * Aligned to 16 bytes so the user pointer keeps malloc's alignment.
+ *
+ * @param size	Size of the user portion
+ * @param slot	Index of the tracker slot last holding the block, a hint only
+ * @param magic	HEADER_MAGIC ^ user pointer, cleared when the block is freed
  */
-enum e_action
+struct s_header
 {
-	ALLOCATE,			/* Allocate new memory */
-	FREE_ALL,			/* Free all tracked allocations */
-	FREE_ONE,			/* Free a specific allocation */
-	GET_USAGE,			/* Get count of current allocations */
-	REALLOC,			/* Reallocate existing memory */
-	ADD_TO_TRACK,		/* Add externally allocated memory to tracking */
-};
-
-/* ************************************************************************** */
-/* 							Function Prototypes                               */
-/* ************************************************************************** */
+	size_t		size;
+	size_t		slot;
+	uintptr_t	magic;
+} __attribute__((aligned(16)));
 
 /**
- * @brief Safe memory management function with multiple operations
- *
- * This function handles memory allocation, deallocation, and tracking with 
- * thread safety using a mutex. It can allocate new memory, free specific or all
- * allocations, get usage statistics, and reallocate memory.
+ * @brief Growable open-addressing table holding the tracked allocations
  *
- * @param size Pointer to size info | interpretation depends on action:
- *        - For ALLOCATE/REALLOC: size[0]=count, size[1]=element size
- *        - For FREE_ONE: size[0]=element count of @double_ptr
- *        - For other actions: Can be NULL
- * @param action Operation to perform (ALLOCATE, FREE_ALL, FREE_ONE,
- *         GET_USAGE, REALLOC, ADD_TO_TRACK)
- * @param ptr Pointer to free or reallocate (for FREE_ONE, REALLOC)
- * @param double_ptr Array of pointers to free (optional with FREE_ONE)
+ * Entries are placed Robin Hood style and removed by backward shift, so
+ * there are no tombstones. A growth moves the previous slot array, with its
+ * counts, to a t_table of its own in old, drained REHASH_STEP slots at a
+ * time. A growth that comes before that migration is over puts the current
+ * array in front of it, so old is a chain, newest first, that lookups check
+ * after slots. No single call ever pays for a whole migration.
  *
- * @return For ALLOCATE/REALLOC: Allocated pointer
- *         For GET_USAGE: Cast (void *)(uintptr_t) of allocation count
- *         For FREE_ONE/FREE_ALL: NULL
- *         On error: NULL
+ * @param slots			Current slot array (capacity is a power of two)
+ * @param capacity		Number of slots in the current array
+ * @param count			Live entries in the current array
+ * @param max_probe		Longest distance from home ever used in slots
+ * @param pending		Live entries still waiting in the whole old chain
+ * @param migrate_pos	In an old table, next slot to migrate
+ * @param old			Arrays being migrated, NULL when no growth is running
  */
-void	*ft_safe_allocate(\
-	size_t *size, t_action action, void *ptr, void **double_ptr);
+struct s_table
+{
+	t_allocation	*slots;
+	size_t			capacity;
+	size_t			count;
+	size_t			max_probe;
+	size_t			pending;
+	size_t			migrate_pos;
+	t_table			*old;
+};
 
 /**
- * @brief Computes a hash value for a pointer
- *
- * This function generates a hash value for a pointer to be used as an index
- * in the allocation tracking hash table.
+ * @brief One lock and the part of the tracking table it protects
  *
- * @param ptr Pointer to hash
+ * Aligned to a cache line so neighbouring shards do not share one.
  *
- * @return Hash value modulo HASH_TABLE_SIZE as an index into the tracking array
+ * @param lock	Mutex guarding table
+ * @param table	Allocations whose hash selects this shard
  */
-size_t	hash_ptr(const void *ptr);
+struct s_shard
+{
+	pthread_mutex_t	lock;
+	t_table			table;
+} __attribute__((aligned(64)));
 
 /**
- *  Action functions
+ * @brief Slot of the lock-free tracking table
+ *
+ * key is NULL (never used), SLOT_TOMBSTONE (released), a user pointer, or
+ * a user pointer with SLOT_BUSY_BIT set while its owner edits entry.
+ *
+ * @param key	Atomic slot state, compared-and-swapped by every writer
+ * @param entry	Tracking data, only written while key carries SLOT_BUSY_BIT
  */
+struct s_lf_slot
+{
+	void *_Atomic	key;
+	t_allocation	entry;
+};
+
+# if LOCK_FREE_TRACKING
 
 /**
- * @brief Allocates memory and adds it to the tracking system
+ * @brief Process-wide allocation tracker (lock-free mode)
  *
- * This function allocates memory of the specified size and adds it to
- * the allocation tracking array. It handles memory fencing if enabled.
- *
- * @param size Pointer to size array: size[0]=count, size[1]=element size
- * @param ptr_array The allocation tracking array
- *
- * @return Pointer to the allocated memory, or NULL on failure
+ * @param slots		Fixed open-addressing table probed linearly
+ * @param live		Number of live entries in slots
+ * @param max_probe	Longest probe any insert has made, lookups stop there
+ * @param spilled	Number of entries in overflow, 0 skips it on lookups
+ * @param warned	Set once WARN_LOCKFREE_SPILL has been printed
+ * @param overflow	Locked table for blocks that found no slot
  */
-void	*allocate_ptr(size_t *size, t_allocation *ptr_array);
+struct s_tracker
+{
+	t_lf_slot		slots[LOCKFREE_TABLE_SIZE];
+	atomic_size_t	live;
+	atomic_size_t	max_probe;
+	atomic_size_t	spilled;
+	atomic_bool		warned;
+	t_shard			overflow;
+};
+
+# else
 
 /**
- * @brief Frees all tracked allocations
- *
- * This function iterates through the tracking array and frees all
- * non-NULL pointers that have been allocated by the system.
- *
- * @param ptr_array The allocation tracking array
+ * @brief Process-wide allocation tracker
  *
- * @return Always returns NULL to indicate all memory has been freed
+ * @param shards	SHARD_COUNT independently locked tables
  */
-void	*free_all(t_allocation *ptr_array);
+struct s_tracker
+{
+	t_shard	shards[SHARD_COUNT];
+};
+
+# endif
 
 /**
- * @brief Handles specific free operations based on provided parameters
+ * @brief Per-thread magazine of recent allocations and reusable blocks
  *
- * This function serves as a router for different types of free operations
- * based on the parameters provided. It can free a single pointer or an array.
- *
- * @param ptr_array The allocation tracking array
- * @param ptr The pointer to free
- * @param double_ptr Optional array of pointers to free
- * @param size Optional size information
+ * Each half is an open-addressed table keyed by hash_ptr(), with the slot
+ * states of the lock-free tracker. The owning thread inserts and removes
+ * without a lock; other threads claim a slot with SLOT_BUSY_BIT, and only
+ * while they hold lock. Merging a half into the tracker takes lock too.
  *
- * @return Always returns NULL to indicate the memory has been freed
+ * @param lock		Held to merge a half, and by any other thread's access
+ * @param slots		Allocations not merged yet, as a young and an old half
+ * @param used		Slots filled in each half since it was last cleared
+ * @param filter	Two bits per pointer placed in each half, from its hash
+ * @param bypass	Allocations left to record straight in the tracker
+ * @param young		Index of the half receiving new allocations
+ * @param cache		Freed blocks kept for reuse (original_ptr, total size)
+ * @param ncache	Number of entries in cache
+ * @param owned		Whether a live thread uses the magazine
+ * @param next		Next magazine in the registry
  */
-void	*free_specific(\
-	t_allocation *ptr_array, const void *ptr, void **double_ptr, size_t *size);
+struct s_magazine
+{
+	pthread_mutex_t	lock;
+	t_lf_slot		slots[2][MAGAZINE_SIZE];
+	size_t			used[2];
+	uint64_t		filter[2][MAGAZINE_SIZE / 8];
+	size_t			bypass;
+	int				young;
+	t_allocation	cache[MAGAZINE_CACHE];
+	size_t			ncache;
+	atomic_bool		owned;
+	t_magazine		*next;
+};
 
 /**
- * @brief Gets the number of active allocations in the tracking system
+ * @brief List of every magazine ever created
  *
- * This function counts the number of non-NULL pointers in the tracking array
- * to determine how many active allocations are being tracked.
+ * Magazines are never freed: one left by an exiting thread is handed to
+ * the next new thread, so the list can be read without the lock. Locked
+ * before any magazine lock, and magazine locks before shard locks.
  *
- * @param ptr_array The allocation tracking array
- *
- * @return Number of active allocations
+ * @param lock	Guards adding and handing out magazines
+ * @param key	Thread-specific key holding each thread's magazine
+ * @param head	Most recently created magazine
  */
-size_t		get_allocation_count(t_allocation *ptr_array);
+struct s_registry
+{
+	pthread_mutex_t		lock;
+	pthread_key_t		key;
+	t_magazine *_Atomic	head;
+};
 
 /**
- * @brief Reallocates memory while maintaining tracking information
- *
- * This function changes the size of a previously allocated memory block
- * while preserving its contents and updating the tracking information.
+ * @brief Allocation statistics filled by the GET_STATS action
  *
- * @param size Pointer to size array: size[0]=new size, size[1]=n of memecopy size
- * @param ptr_array The allocation tracking array
- * @param ptr The pointer to reallocate
+ * Fields are read one by one without a lock, so under concurrent
+ * allocations they may come from slightly different instants.
  *
- * @return Pointer to the reallocated memory, or NULL on failure
+ * @param live_blocks	Allocations currently tracked
+ * @param live_bytes	Bytes currently tracked (user portion only)
+ * @param peak_bytes	Highest value live_bytes has reached
+ * @param total_allocs	Allocations tracked since the start of the program
+ * @param total_frees	Allocations released since the start of the program
+ * @param dropped_diagnostics	Messages lost because the ring was full
  */
-void	*realloc_ptr(\
-	size_t *size, t_allocation *ptr_array, void *ptr, t_action action);
+struct s_alloc_stats
+{
+	size_t	live_blocks;
+	size_t	live_bytes;
+	size_t	peak_bytes;
+	size_t	total_allocs;
+	size_t	total_frees;
+	size_t	dropped_diagnostics;
+};
 
 /**
- * @brief Adds externally allocated memory to the tracking system
+ * @brief Live counters behind t_alloc_stats
  *
- * This function allows adding memory that was allocated outside the
- * ft_safe_allocate system to be tracked and safely freed later.
- *
- * @param ptr_array The allocation tracking array
- * @param original_ptr The original pointer from malloc/calloc
- * @param user_ptr The user-facing pointer (same as original_ptr if no fencing)
- * @param size Pointer to the size of the allocated memory
+ * Updated with relaxed atomics whenever an entry enters or leaves the
+ * tracker, so reading them never takes a lock or walks the table.
+ * live_blocks is derived as total_allocs - total_frees.
+ */
+struct s_counters
+{
+	atomic_size_t	live_bytes;
+	atomic_size_t	peak_bytes;
+	atomic_size_t	total_allocs;
+	atomic_size_t	total_frees;
+} __attribute__((aligned(64)));
+
+/**
+ * @brief Free list and current slab of one size class
  *
- * @return SUCCESS if successfully added, ERROR otherwise
+ * @param lock		Guards every other field
+ * @param free_list	Freed blocks, linked through their first word
+ * @param bump		Next unused byte of the current slab
+ * @param remaining	Unused bytes left in the current slab
  */
-int		add_to_tracking(\
-	t_allocation *ptr_array, void *original_ptr, void *user_ptr, size_t *size);
+struct s_slab_class
+{
+	pthread_mutex_t	lock;
+	void			*free_list;
+	unsigned char	*bump;
+	size_t			remaining;
+} __attribute__((aligned(64)));
 
 /**
- *  	cleanup functions
+ * @brief Chunk of an arena; blocks are bump-allocated right after it
+ *
+ * @param next		Previously filled chunk of the same arena
+ * @param capacity	Bytes available after the chunk header
+ * @param used		Bytes already handed out
  */
+struct s_arena_chunk
+{
+	t_arena_chunk	*next;
+	size_t			capacity;
+	size_t			used;
+} __attribute__((aligned(16)));
 
 /**
- * @brief Frees an array of pointers tracked in the allocation system
+ * @brief Group of allocations released together by ARENA_END
  *
- * This function frees a list of pointers stored in a double pointer array.
- * It will free 'count' number of pointers from the array.
+ * Arena blocks are not stored in the tracker: they count in GET_USAGE and
+ * GET_STATS but cannot be passed to FREE_ONE or REALLOC, and FREE_ALL
+ * leaves them alone. An arena must not be used by two threads at once.
  *
- * @param ptr_array The allocation tracking array
- * @param double_ptr Array of pointers to free
+ * @param chunks	Most recent chunk, the one blocks are carved from
+ * @param blocks	Number of blocks handed out
+ * @param bytes		User bytes handed out
+ */
+struct s_arena
+{
+	t_arena_chunk	*chunks;
+	size_t			blocks;
+	size_t			bytes;
+};
+
+/**
+ * @brief Request passed to the tracker when REALLOC resizes in place
+ *
+ * @param size		REALLOC size array: size[0]=new size, size[1]=bytes kept
+ * @param user_ptr	Set to the resized block's user pointer on success
+ */
+struct s_resize
+{
+	size_t	*size;
+	void	*user_ptr;
+};
+
+/**
+ * @brief Sort key of one entry of a batch
+ *
+ * @param key	Shard index, then bucket index within the shard
+ * @param index	Position of the entry in the caller's array
+ */
+struct s_batch_key
+{
+	size_t	key;
+	size_t	index;
+};
+
+/**
+ * @brief memset/memcpy implementations picked for this CPU
+ *
+ * @param set	Implementation behind ft_memset_sa()
+ * @param copy	Implementation behind ft_memcpy_sa()
+ * @param name	"scalar", "sse2" or "avx2"
+ */
+struct s_memops
+{
+	void		*(*set)(void *b, int c, size_t len);
+	void		*(*copy)(void *dst, const void *src, size_t n);
+	const char	*name;
+};
+
+/**
+ * @brief One formatted diagnostic line
+ *
+ * seq follows the bounded queue scheme: a slot is free for the message
+ * numbered seq, holds message seq - 1 once published, and becomes free
+ * again for message seq - 1 + DIAG_SLOTS when flushed.
+ *
+ * @param seq	Message number the slot is waiting for, plus one if full
+ * @param len	Bytes used in text
+ * @param text	The line, not NUL-terminated
+ */
+struct s_diag_slot
+{
+	atomic_size_t	seq;
+	size_t			len;
+	char			text[DIAG_LINE];
+};
+
+/**
+ * @brief Ring of diagnostics waiting to be written
+ *
+ * Producers only touch head, dropped, started and their own slot, so
+ * reporting never takes a lock. flush_lock serializes flushes and guards
+ * tail, reported, fd and owned_fd.
+ *
+ * @param head		Number given to the next message
+ * @param dropped	Messages lost because the ring was full
+ * @param started	Whether a flusher thread is running
+ * @param direct	Set at exit: later messages are written immediately
+ * @param flush_lock	Serializes flushes
+ * @param tail		Number of the next message to write
+ * @param reported	Part of dropped already reported in the output
+ * @param fd		Where lines are written
+ * @param owned_fd	Whether fd was opened by DIAG_TARGET
+ * @param slots		The lines
+ */
+struct s_diag
+{
+	atomic_size_t	head;
+	atomic_size_t	dropped;
+	atomic_bool		started;
+	atomic_bool		direct;
+	pthread_mutex_t	flush_lock;
+	size_t			tail;
+	size_t			reported;
+	int				fd;
+	bool			owned_fd;
+	t_diag_slot		slots[DIAG_SLOTS];
+};
+
+/**
+ * @brief Action enum for ft_safe_allocate function
+ */
+enum e_action
+{
+	ALLOCATE,			/* Allocate new memory */
+	FREE_ALL,			/* Free all tracked allocations */
+	FREE_ONE,			/* Free a specific allocation */
+	GET_USAGE,			/* Get bytes held by live allocations */
+	REALLOC,			/* Reallocate existing memory */
+	ADD_TO_TRACK,		/* Add externally allocated memory to tracking */
+	GET_STATS,			/* Fill a t_alloc_stats passed as ptr */
+	ARENA_BEGIN,		/* Create an arena, returned as the result */
+	ARENA_ALLOCATE,		/* Allocate from the arena passed as ptr */
+	ARENA_END,			/* Release the arena passed as ptr and its blocks */
+	ALLOCATE_UNINIT,	/* ALLOCATE without zeroing the block */
+	ALLOCATE_BATCH,		/* Fill double_ptr with size[0] new blocks */
+	FREE_BATCH,			/* Free the size[0] blocks listed in double_ptr */
+	DIAG_TARGET,		/* Send diagnostics to the file ptr or fd size[0] */
+	GET_PROFILE,		/* Fill a t_profile passed as ptr (INSTRUMENT) */
+	GET_SITES,			/* Fill up to size[0] t_site_stats (ALLOC_SITES) */
+	LEAK_REPORT,		/* Report live blocks at exit to file ptr or fd */
+	SAMPLE_RATE,		/* Sample every size[0] bytes (HEAP_PROFILE) */
+	HEAP_DUMP,			/* Write the heap profile to file ptr or fd */
+	ALLOCATE_ALIGNED,	/* ALLOCATE aligned to size[2] bytes */
+	ACTION_COUNT,		/* Number of actions, not an action */
+};
+
+/**
+ * @brief Instrumentation counters filled by the GET_PROFILE action
+ *
+ * Like t_alloc_stats, fields are read one by one without a lock.
+ *
+ * @param calls		Calls of each action
+ * @param cycles	Total latency of each action, in INSTR_UNIT
+ * @param latency	Per action, calls whose latency fell in each bucket
+ * @param lock_acquires	Shard lock acquisitions
+ * @param lock_waits	Acquisitions that found the lock taken
+ * @param lock_wait_cycles	Time spent waiting for those, in INSTR_UNIT
+ * @param probes	Slots read per lookup (INSTR_FIND) and per placement
+ *					of an entry, rehash moves included (INSTR_PLACE); the
+ *					last bucket counts INSTR_PROBES slots or more
+ * @param fence_checks	Guard checks run by check_memfen()
+ * @param fence_cycles	Time spent in them, in INSTR_UNIT
+ */
+struct s_profile
+{
+	size_t	calls[ACTION_COUNT];
+	size_t	cycles[ACTION_COUNT];
+	size_t	latency[ACTION_COUNT][INSTR_BUCKETS];
+	size_t	lock_acquires;
+	size_t	lock_waits;
+	size_t	lock_wait_cycles;
+	size_t	probes[2][INSTR_PROBES];
+	size_t	fence_checks;
+	size_t	fence_cycles;
+};
+
+/**
+ * @brief Live counters behind t_profile, field for field
+ *
+ * Updated with relaxed atomics. GET_PROFILE copies them word by word, so
+ * both structures must keep the same layout.
+ */
+struct s_instr
+{
+	atomic_size_t	calls[ACTION_COUNT];
+	atomic_size_t	cycles[ACTION_COUNT];
+	atomic_size_t	latency[ACTION_COUNT][INSTR_BUCKETS];
+	atomic_size_t	lock_acquires;
+	atomic_size_t	lock_waits;
+	atomic_size_t	lock_wait_cycles;
+	atomic_size_t	probes[2][INSTR_PROBES];
+	atomic_size_t	fence_checks;
+	atomic_size_t	fence_cycles;
+};
+
+/**
+ * @brief Counters of one allocating site, filled by the GET_SITES action
+ *
+ * @param caller		Return address of the ft_safe_allocate() call, NULL
+ *						for blocks counted after the site table filled up
+ * @param live_blocks	Blocks from this site still tracked
+ * @param live_bytes	Their total size (user portion only)
+ * @param total_allocs	Blocks tracked from this site since the start
+ */
+struct s_site_stats
+{
+	void	*caller;
+	size_t	live_blocks;
+	size_t	live_bytes;
+	size_t	total_allocs;
+};
+
+/**
+ * @brief Live counters behind t_site_stats
+ *
+ * caller is claimed once by compare-and-swap from NULL and never changes.
+ */
+struct s_site
+{
+	void *_Atomic	caller;
+	atomic_size_t	live_blocks;
+	atomic_size_t	live_bytes;
+	atomic_size_t	total_allocs;
+};
+
+/**
+ * @brief Interned allocation sites
+ *
+ * @param slots	Slot 0 counts overflow; sites are probed linearly in the
+ *				SITE_SLOTS slots after it
+ */
+struct s_sites
+{
+	t_site	slots[SITE_SLOTS + 1];
+};
+
+/**
+ * @brief Settings of the leak report armed by LEAK_REPORT
+ *
+ * @param lock		Guards every other field; held while the report runs
+ * @param armed		Whether LEAK_REPORT was called
+ * @param done		Whether the report was written since then
+ * @param format	LEAK_TEXT or LEAK_CSV
+ * @param fd		Where the report goes
+ * @param owned_fd	Whether fd was opened by LEAK_REPORT
+ */
+struct s_leak
+{
+	pthread_mutex_t	lock;
+	bool			armed;
+	bool			done;
+	int				format;
+	int				fd;
+	bool			owned_fd;
+};
+
+/**
+ * @brief Live blocks of one size from one site
+ *
+ * @param size	Size of each block (user portion only)
+ * @param site	Site index, 0 without ALLOC_SITES
+ * @param count	Number of blocks, 0 for an unused slot
+ */
+struct s_leak_group
+{
+	size_t	size;
+	size_t	site;
+	size_t	count;
+};
+
+/**
+ * @brief Groups collected for the leak report
+ *
+ * @param slots		Open-addressing table of groups, NULL if memory ran out
+ * @param capacity	Slots in the table (a power of two)
+ * @param used		Groups in the table
+ * @param blocks	Blocks seen, grouped or not
+ * @param bytes		Their total size
+ */
+struct s_leak_groups
+{
+	t_leak_group	*slots;
+	size_t			capacity;
+	size_t			used;
+	size_t			blocks;
+	size_t			bytes;
+};
+
+/**
+ * @brief Output buffer of the leak report and the heap profile
+ *
+ * @param fd	Where full buffers are written
+ * @param len	Bytes waiting in buf
+ * @param buf	Pending output
+ */
+struct s_out
+{
+	int		fd;
+	size_t	len;
+	char	buf[OUT_BUFFER];
+};
+
+/**
+ * @brief Per-thread state of the heap sampler
+ *
+ * @param countdown	Bytes left before the next sample
+ * @param rng		xorshift64* state
+ * @param seeded	Whether rng was seeded and a first countdown drawn
+ */
+struct s_sampler
+{
+	int64_t		countdown;
+	uint64_t	rng;
+	bool		seeded;
+};
+
+/**
+ * @brief Sampled allocations sharing one stack
+ *
+ * @param hash			Hash of the stack, 0 for an unused bucket
+ * @param depth			Frames in stack
+ * @param stack			Return addresses, innermost first
+ * @param inuse_count	Sampled blocks still tracked
+ * @param inuse_bytes	Their total size
+ * @param alloc_count	Blocks sampled since the start
+ * @param alloc_bytes	Their total size
+ */
+struct s_heap_bucket
+{
+	uint64_t	hash;
+	size_t		depth;
+	void		*stack[HEAP_DEPTH];
+	size_t		inuse_count;
+	size_t		inuse_bytes;
+	size_t		alloc_count;
+	size_t		alloc_bytes;
+};
+
+/**
+ * @brief Heap profile shared by every thread
+ *
+ * @param lock		Guards the buckets
+ * @param rate		Mean bytes between samples, 0 when sampling is off
+ * @param scale		Last rate other than 0, written in the profile header
+ * @param buckets	HEAP_BUCKETS + 1 buckets, allocated on first use; bucket
+ *					0 holds the stacks that found the table full, the
+ *					others are probed linearly by stack hash
+ */
+struct s_heap
+{
+	pthread_mutex_t	lock;
+	_Atomic size_t	rate;
+	_Atomic size_t	scale;
+	t_heap_bucket	*buckets;
+};
+
+/**
+ * @brief State of the fence scrubber
+ *
+ * @param lock		Held by the scrubber for each step, and by
+ *					fork_handlers_sa() around fork()
+ * @param cursor	Shard and slot the next step starts from
+ */
+struct s_scrub
+{
+	pthread_mutex_t	lock;
+	size_t			cursor[2];
+};
+
+/* ************************************************************************** */
+/* 							Function Prototypes                               */
+/* ************************************************************************** */
+
+/**
+ * @brief Allocator the library itself draws its blocks and tables from
+ */
+# if PRELOAD
+
+void	*__libc_malloc(size_t size);
+void	*__libc_calloc(size_t count, size_t size);
+void	*__libc_realloc(void *ptr, size_t size);
+void	__libc_free(void *ptr);
+void	*__libc_memalign(size_t align, size_t size);
+
+#  define RAW_MALLOC __libc_malloc
+#  define RAW_REALLOC __libc_realloc
+#  define RAW_FREE __libc_free
+#  define PRELOAD_API __attribute__((visibility("default")))
+# else
+#  define RAW_MALLOC malloc
+#  define RAW_REALLOC realloc
+#  define RAW_FREE free
+# endif
+
+/**
+ * @brief Safe memory management function with multiple operations
+ *
+ * This function handles memory allocation, deallocation, and tracking with 
+ * thread safety using one mutex per tracking shard. It can allocate new
+ * memory, free specific or all allocations, get usage statistics, and
+ * reallocate memory.
+ *
+ * @param size Pointer to size info | interpretation depends on action:
+ *        - For ALLOCATE/ALLOCATE_UNINIT/REALLOC: size[0]=count,
+ *          size[1]=element size
+ *        - For FREE_ONE: size[0]=element count of @double_ptr
+ *        - For ALLOCATE_BATCH: size[0]=count, size[1]=size of each block
+ *        - For FREE_BATCH: size[0]=element count of @double_ptr
+ *        - For DIAG_TARGET: size[0]=file descriptor, when ptr is NULL
+ *        - For GET_SITES: size[0]=entries available in ptr
+ *        - For LEAK_REPORT: size[0]=file descriptor, when ptr is NULL,
+ *          size[1]=LEAK_TEXT or LEAK_CSV
+ *        - For SAMPLE_RATE: size[0]=mean bytes between samples, 0 to stop
+ *        - For HEAP_DUMP: size[0]=file descriptor, when ptr is NULL
+ *        - For ALLOCATE_ALIGNED: size[0]=count, size[1]=element size,
+ *          size[2]=alignment, a power of two up to the page size
+ *        - For other actions: Can be NULL
+ * @param action Operation to perform (ALLOCATE, FREE_ALL, FREE_ONE,
+ *         GET_USAGE, REALLOC, ADD_TO_TRACK, GET_STATS, ARENA_BEGIN,
+ *         ARENA_ALLOCATE, ARENA_END, ALLOCATE_UNINIT, ALLOCATE_BATCH,
+ *         FREE_BATCH, DIAG_TARGET, GET_PROFILE, GET_SITES, LEAK_REPORT,
+ *         SAMPLE_RATE, HEAP_DUMP, ALLOCATE_ALIGNED)
+ * @param ptr Pointer to free or reallocate (for FREE_ONE, REALLOC), the
+ *        t_alloc_stats or t_profile to fill (for GET_STATS, GET_PROFILE),
+ *        the array of size[0] t_site_stats to fill (for GET_SITES),
+ *        or the arena (for
+ *        ARENA_ALLOCATE/ARENA_END), or an optional array of size[0] block
+ *        sizes overriding size[1] (for ALLOCATE_BATCH), or the path of
+ *        the file diagnostics are appended to (for DIAG_TARGET), or the
+ *        path of the file the leak report replaces (for LEAK_REPORT), or
+ *        the path of the file the heap profile replaces (for HEAP_DUMP)
+ * @param double_ptr Array of pointers to free (optional with FREE_ONE,
+ *        required with FREE_BATCH), or the array ALLOCATE_BATCH fills
+ *
+ * @return For ALLOCATE/ALLOCATE_UNINIT/REALLOC/ARENA_ALLOCATE/
+ *         ALLOCATE_ALIGNED: Allocated pointer, BLOCK_ALIGN aligned at
+ *         least
+ *         For ARENA_BEGIN: The new arena (t_arena *)
+ *         For ALLOCATE_BATCH: double_ptr
+ *         For GET_USAGE: Cast (void *)(uintptr_t) of live bytes
+ *         For GET_STATS: ptr, or NULL if ptr is NULL
+ *         For GET_PROFILE: ptr, or NULL if ptr is NULL or INSTRUMENT is
+ *         off
+ *         For GET_SITES: Cast (void *)(uintptr_t) of the number of
+ *         entries filled, or of sites in use if ptr or size is NULL
+ *         For FREE_ONE/FREE_ALL/FREE_BATCH/DIAG_TARGET/LEAK_REPORT/
+ *         SAMPLE_RATE/HEAP_DUMP: NULL
+ *         On error: NULL
+ */
+void	*ft_safe_allocate(\
+	size_t *size, t_action action, void *ptr, void **double_ptr);
+
+/**
+ * @brief Typed entry points for the hot actions, without the action
+ *        dispatch or the size array
+ *
+ * sa_alloc() is ALLOCATE, sa_free() is FREE_ONE on one pointer,
+ * sa_realloc() is REALLOC with old_size bytes copied and sa_usage() is
+ * GET_USAGE. They share their code with ft_safe_allocate(), which calls
+ * the same bodies for these actions, so both can be mixed freely. Blocks
+ * are tagged with, and instrumented as, their action either way.
+ *
+ * @param count Number of elements
+ * @param size Size of each element
+ * @param ptr Block to free or resize; sa_free(NULL) does nothing
+ * @param old_size Bytes of ptr to keep
+ * @param new_size Size of the resized block, 0 frees ptr
+ *
+ * @return sa_alloc()/sa_realloc(): The block, or NULL on failure
+ *         sa_usage(): Bytes held by live allocations
+ */
+void	*sa_alloc(size_t count, size_t size);
+void	sa_free(void *ptr);
+void	*sa_realloc(void *ptr, size_t old_size, size_t new_size);
+size_t	sa_usage(void);
+
+/**
+ * @brief Runs every action but ALLOCATE, ALLOCATE_UNINIT, REALLOC,
+ *        GET_USAGE and FREE_ONE on a single pointer
+ *
+ * Called by ft_safe_allocate() once it has noted the caller.
+ */
+void	*dispatch_sa(
+	size_t *size, t_action action, void *ptr, void **double_ptr);
+
+/**
+ * @brief Returns the process-wide tracker, initializing it on first use
+ *
+ * @return Pointer to the tracker shared by every ft_safe_allocate() call
+ */
+t_tracker	*tracker_sa(void);
+
+/**
+ * @brief Selects the shard responsible for a pointer
+ *
+ * Uses the high bits of hash_ptr() so they stay independent of the
+ * low bits used for the slot index inside the shard.
+ *
+ * @param tracker The allocation tracker
+ * @param ptr The user pointer
+ *
+ * @return The shard whose table holds (or will hold) ptr
+ */
+t_shard		*shard_for_sa(t_tracker *tracker, const void *ptr);
+
+/**
+ * @brief Adds an entry to the tracker
+ *
+ * Locks only the shard owning entry->user_ptr, or claims a slot by
+ * compare-and-swap in lock-free mode.
+ *
+ * @param tracker The allocation tracker
+ * @param entry The entry to copy into the tracker
+ *
+ * @return SUCCESS, or ERROR if the tracker has no room left
+ */
+int			tracker_insert_sa(t_tracker *tracker, const t_allocation *entry);
+
+/**
+ * @brief Removes a pointer from the tracker
+ *
+ * Only the shard owning ptr is locked, and only for the table update;
+ * the caller releases the memory after the lock is dropped.
+ *
+ * @param tracker The allocation tracker
+ * @param ptr The user pointer to stop tracking
+ * @param entry Receives a copy of the removed entry
+ *
+ * @return SUCCESS if ptr was tracked, ERROR otherwise
+ */
+int			untrack_sa(\
+	t_tracker *tracker, const void *ptr, t_allocation *entry);
+
+/**
+ * @brief Removes every entry from the tracker and hands each one to fn
+ *
+ * fn runs on a copy of the entry, after the entry left the tracker and
+ * outside any lock.
+ *
+ * @param tracker The allocation tracker
+ * @param fn Callback receiving the removed entry and arg
+ * @param arg Opaque argument forwarded to fn
+ */
+void		tracker_drain_sa(\
+	t_tracker *tracker, void (*fn)(t_allocation *, void *), void *arg);
+
+/**
+ * @brief Calls fn on every entry of the tracker without removing it
+ *
+ * Shards are locked one at a time. In lock-free mode the walk takes no
+ * ownership: entries that change while being read are skipped.
+ *
+ * @param tracker The allocation tracker
+ * @param fn Callback receiving a copy of each entry and arg
+ * @param arg Opaque argument forwarded to fn
+ */
+void		tracker_foreach_sa(\
+	t_tracker *tracker, void (*fn)(t_allocation *, void *), void *arg);
+
+/**
+ * @brief Runs op (pthread_mutex_lock or _unlock) on every tracker lock,
+ *        the shard locks or the lock-free overflow lock
+ */
+void		tracker_locks_sa(t_tracker *tracker, int (*op)(pthread_mutex_t *));
+
+/**
+ * @brief Counts live tracked entries by distance from their home slot
+ *
+ * hist[d] receives the entries d slots past home; the last bucket also
+ * counts every longer one. Shards are locked one at a time.
+ *
+ * @param tracker The allocation tracker
+ * @param hist Array of n counters, zeroed first
+ * @param n Number of counters
+ */
+void		tracker_probe_histogram_sa(\
+	t_tracker *tracker, size_t *hist, size_t n);
+
+/**
+ * @brief Adds several entries, taking each shard lock once
+ *
+ * Entries are sorted by shard, and within a shard by bucket once the
+ * table has been grown to fit them all, so every shard is visited once
+ * and its slots in address order. In lock-free mode this is a plain loop
+ * over tracker_insert_sa().
+ *
+ * @param tracker The allocation tracker
+ * @param entries Entries to copy into the tracker
+ * @param n Number of entries
+ *
+ * @return SUCCESS, or ERROR if the tracker ran out of room
+ */
+int			tracker_insert_batch_sa(\
+	t_tracker *tracker, const t_allocation *entries, size_t n);
+
+/**
+ * @brief Removes several entries, taking each shard lock once
+ *
+ * Same ordering as tracker_insert_batch_sa(). On input entries[i].user_ptr
+ * holds a pointer to remove; on output entries[i] is the removed entry,
+ * or has a NULL user_ptr if the pointer was not in the shards.
+ *
+ * @param tracker The allocation tracker
+ * @param entries Pointers in, removed entries out
+ * @param n Number of entries
+ *
+ * @return Number of entries removed
+ */
+size_t		tracker_remove_batch_sa(\
+	t_tracker *tracker, t_allocation *entries, size_t n);
+
+/**
+ * @brief Sort keys for a batch, grouped by shard
+ *
+ * Uses stack when n fits BATCH_CHUNK, a temporary array otherwise.
+ *
+ * @param tracker The allocation tracker
+ * @param entries The batch; only user_ptr is read
+ * @param n Number of entries
+ * @param stack Array of BATCH_CHUNK keys to use for small batches
+ *
+ * @return The sorted keys, or NULL if the array could not be allocated
+ */
+t_batch_key	*batch_keys_sa(t_tracker *tracker,
+				const t_allocation *entries, size_t n, t_batch_key *stack);
+
+/**
+ * @brief Re-keys one shard's run of a batch by the top bits of its
+ *        bucket and sorts it
+ *
+ * Called with the shard locked, after any growth, so the bucket order
+ * matches the slots the entries will be placed in or found at.
+ */
+void		batch_sort_run_sa(t_table *table,
+				const t_allocation *entries, t_batch_key *run, size_t m);
+
+/**
+ * @brief Runs fn on the tracked entry of ptr, in place
+ *
+ * The shard stays locked (or the lock-free slot claimed) while fn runs,
+ * so fn must be short and must not change entry->user_ptr, the key.
+ * Moving a block goes through tracker_rekey_sa() instead.
+ *
+ * @param tracker The allocation tracker
+ * @param ptr The user pointer to look up
+ * @param fn Callback receiving the live entry and arg
+ * @param arg Opaque argument forwarded to fn
+ *
+ * @return SUCCESS if ptr was tracked, ERROR otherwise
+ */
+int			tracker_update_sa(t_tracker *tracker, const void *ptr,
+				void (*fn)(t_allocation *, void *), void *arg);
+
+/**
+ * @brief Copies the tracked entry of ptr and parks it for a resize
+ *
+ * The entry stays tracked, but nothing touches its block until
+ * tracker_rekey_sa(): sharded, the tracked copy loses its original_ptr;
+ * lock-free, the slot stays claimed. Every park must be followed by a
+ * rekey.
+ *
+ * @param tracker The allocation tracker
+ * @param ptr The user pointer to look up
+ * @param entry Receives a copy of the entry
+ * @param claimed Receives the claimed slot (lock-free mode), or NULL
+ *
+ * @return SUCCESS if ptr was parked, ERROR if it is not tracked (or only
+ *         in the lock-free overflow table)
+ */
+int			tracker_park_sa(t_tracker *tracker, const void *ptr,
+				t_allocation *entry, t_lf_slot **claimed);
+
+/**
+ * @brief Replaces the parked entry of ptr with entry, which may have
+ *        another key
+ *
+ * With a new key, both shards are locked at once and the entry moves
+ * between them; with the same key the entry is overwritten in place,
+ * which cannot fail. The old block is never read.
+ *
+ * @param tracker The allocation tracker
+ * @param ptr The user pointer passed to tracker_park_sa()
+ * @param entry The entry to store, keyed by entry->user_ptr
+ * @param claimed The slot tracker_park_sa() returned
+ *
+ * @return SUCCESS, or ERROR if the new key found no room; the old entry
+ *         is gone in that case
+ */
+int			tracker_rekey_sa(t_tracker *tracker, const void *ptr,
+				const t_allocation *entry, t_lf_slot *claimed);
+
+/**
+ * @brief Takes ownership of the lock-free slot holding ptr
+ *
+ * Sets SLOT_BUSY_BIT on the slot key by compare-and-swap. The caller must
+ * store the key back (ptr or SLOT_TOMBSTONE) when done.
+ *
+ * @param tracker The allocation tracker (lock-free mode)
+ * @param ptr The user pointer to look up
+ *
+ * @return The claimed slot, or NULL if ptr is not tracked
+ */
+t_lf_slot	*lf_claim_sa(t_tracker *tracker, const void *ptr);
+
+/**
+ * @brief Raises tracker->max_probe to probes if it is lower
+ *
+ * Called before the new key is published, so a lookup for it always
+ * probes far enough.
+ */
+void		lf_note_probe_sa(t_tracker *tracker, size_t probes);
+
+/**
+ * @brief Overflow table of the lock-free tracker
+ *
+ * Blocks that found no free slot within LOCKFREE_MAX_PROBE are kept in one
+ * mutex-guarded t_table. The remove and update calls return ERROR at once
+ * while it is empty, so lookups only pay for it once the table is full.
+ * lf_spill_walk_sa() runs fn on every entry, and with drain empties the
+ * table first so that fn may free the blocks.
+ */
+int			lf_spill_insert_sa(t_tracker *tracker, const t_allocation *entry);
+int			lf_spill_remove_sa(
+				t_tracker *tracker, const void *ptr, t_allocation *entry);
+int			lf_spill_update_sa(t_tracker *tracker, const void *ptr,
+				void (*fn)(t_allocation *, void *), void *arg);
+void		lf_spill_walk_sa(t_tracker *tracker,
+				void (*fn)(t_allocation *, void *), void *arg, bool drain);
+
+/**
+ * @brief Sets SLOT_BUSY_BIT on a slot holding a live entry
+ *
+ * The caller stores the entry's user pointer back as the key when done.
+ *
+ * @return SUCCESS if the slot was claimed, ERROR if it is empty, released
+ *         or already claimed
+ */
+int			lf_claim_live_sa(t_lf_slot *slot);
+
+/**
+ * @brief Computes a hash value for a pointer
+ *
+ * This function generates a hash value for a pointer to be used as an index
+ * in the allocation tracking hash table.
+ *
+ * @param ptr Pointer to hash
+ *
+ * @return Full mixed hash value, callers mask it with (capacity - 1)
+ */
+size_t	hash_ptr(const void *ptr);
+
+/**
+ *  Action functions
+ */
+
+/**
+ * @brief Allocates memory and adds it to the tracking system
+ *
+ * This function allocates memory of the specified size and adds it to
+ * the allocation tracking array. It handles memory fencing if enabled.
+ *
+ * @param size Pointer to size array: size[0]=count, size[1]=element size
+ * @param tracker The allocation tracker
+ * @param align Alignment of the user pointer, BLOCK_ALIGN or less for the
+ *        default one
+ * @param zero Whether the user bytes must read as zero (false for
+ *        ALLOCATE_UNINIT); guards and header are written either way
+ *
+ * @return Pointer to the allocated memory, or NULL on failure
+ */
+void	*allocate_ptr(
+	size_t *size, t_tracker *tracker, size_t align, bool zero);
+
+/**
+ * @brief ALLOCATE_ALIGNED: checks the alignment in size[2], then
+ *        allocates a zeroed block like allocate_ptr()
+ *
+ * @return The block, or NULL with a warning if the alignment is invalid
+ */
+void	*allocate_aligned(size_t *size, t_tracker *tracker);
+
+/**
+ * @brief User pointer of a block allocated with align extra bytes
+ *
+ * Rounds past BLOCK_PREFIX up to align and stores align in the word in
+ * front of the prefix, where block_total_sa() finds it. Alignments up to
+ * BLOCK_ALIGN need no extra bytes and give block + BLOCK_PREFIX.
+ */
+unsigned char	*align_block_sa(unsigned char *block, size_t align);
+
+/**
+ * @brief Size the block of entry was requested with
+ *
+ * entry->size + BLOCK_OVERHEAD, plus the alignment for blocks whose
+ * prefix does not start at original_ptr.
+ */
+size_t	block_total_sa(const t_allocation *entry);
+
+/**
+ * @brief Allocates one block and fills its entry, without tracking it
+ *
+ * Writes the guards and inline header like allocate_ptr().
+ *
+ * @param entry Receives original_ptr, user_ptr and size
+ * @param bytes User size of the block
+ * @param align Alignment of the user pointer, as in allocate_ptr()
+ * @param zero Whether the user bytes must read as zero
+ *
+ * @return SUCCESS, or ERROR if the size overflows or allocation failed
+ */
+int		new_block_sa(
+	t_allocation *entry, size_t bytes, size_t align, bool zero);
+
+/**
+ * @brief Entry array for a batch of n: stack when n fits BATCH_CHUNK,
+ *        malloc otherwise (NULL on failure)
+ */
+t_allocation	*batch_entries_sa(size_t n, t_allocation *stack);
+
+/**
+ * @brief Allocates a batch of blocks and tracks them in one pass
+ *
+ * The blocks are allocated first, then recorded with a single
+ * tracker_insert_batch_sa(), so each shard is locked once per batch.
+ * If a block cannot be allocated or tracked, every block of the batch is
+ * freed and its stats and site counts taken back before
+ * error_cleanup_sa() runs.
+ *
+ * @param size size[0]=count, size[1]=size of every block
+ * @param sizes Optional array of size[0] sizes overriding size[1]
+ * @param out Receives the size[0] user pointers
+ * @param tracker The allocation tracker
+ *
+ * @return out, or NULL if size or out is NULL
+ */
+void	*allocate_batch(size_t *size, const size_t *sizes, void **out,
+			t_tracker *tracker);
+
+/**
+ * @brief Frees a batch of tracked blocks and NULLs their array entries
+ *
+ * Entries are removed with one tracker_remove_batch_sa(). Pointers not
+ * found there (still in a thread magazine, or not tracked at all) go
+ * through free_specific() one by one. NULL entries are skipped.
+ *
+ * @param size size[0]=number of pointers in ptrs
+ * @param ptrs The pointers to free
+ * @param tracker The allocation tracker
+ *
+ * @return NULL
+ */
+void	*free_batch(size_t *size, void **ptrs, t_tracker *tracker);
+
+/**
+ * @brief Grows or shrinks a tracked block without copying when possible
+ *
+ * Malloc-backed blocks go through realloc(); slab blocks stay put while
+ * they keep their size class. The end guard and inline header are
+ * rewritten. The entry stays tracked, parked by tracker_park_sa(), and
+ * no lock is held over realloc() or mremap(); tracker_rekey_sa() then
+ * puts the new entry in its place.
+ *
+ * @param tracker The allocation tracker
+ * @param ptr The block to resize
+ * @param size REALLOC size array: size[0]=new size, size[1]=bytes kept
+ * @param new_ptr Receives the resized block
+ *
+ * @return SUCCESS if the block was resized, ERROR if REALLOC has to
+ *         allocate and copy, in which case ptr is still tracked and intact
+ */
+int		resize_in_place_sa(t_tracker *tracker, void *ptr, size_t *size,
+			void **new_ptr);
+
+/**
+ * @brief Resizes the block of a copy of a tracked entry, rewriting the
+ *        copy on success
+ *
+ * Sets resize->user_ptr to the new user pointer, leaves it NULL when the
+ * block has to be copied.
+ */
+void	resize_entry_sa(t_allocation *entry, t_resize *resize);
+
+/**
+ * @brief Frees all tracked allocations
+ *
+ * This function iterates through the tracking array and frees all
+ * non-NULL pointers that have been allocated by the system.
+ *
+ * @param tracker The allocation tracker
+ *
+ * @return Always returns NULL to indicate all memory has been freed
+ */
+void	*free_all(t_tracker *tracker);
+
+/**
+ * @brief Handles specific free operations based on provided parameters
+ *
+ * This function serves as a router for different types of free operations
+ * based on the parameters provided. It can free a single pointer or an array.
+ *
+ * @param tracker The allocation tracker
+ * @param ptr The pointer to free
+ * @param double_ptr Optional array of pointers to free
+ * @param size Optional size information
+ *
+ * @return Always returns NULL to indicate the memory has been freed
+ */
+void	*free_specific(\
+	t_tracker *tracker, const void *ptr, void **double_ptr, size_t *size);
+
+/**
+ * @brief Gets the number of bytes currently tracked
+ *
+ * Reads the live counters in O(1) without taking any lock.
+ *
+ * @param tracker The allocation tracker
+ *
+ * @return Bytes held by live allocations (user portion only)
+ */
+size_t	get_allocation_count(t_tracker *tracker);
+
+/**
+ * @brief Copies the live counters into stats
+ *
+ * @param stats Structure to fill
+ *
+ * @return stats, or NULL if stats is NULL
+ */
+void	*get_stats(t_alloc_stats *stats);
+
+/**
+ * @brief Accounts for allocations entering the tracker
+ *
+ * Also raises peak_bytes when live_bytes passes it.
+ *
+ * @param count Number of allocations
+ * @param bytes Their total size (user portion only)
+ */
+void	stats_add_sa(size_t count, size_t bytes);
+
+/**
+ * @brief Accounts for allocations being released
+ *
+ * @param count Number of allocations
+ * @param bytes Their total size (user portion only)
+ */
+void	stats_remove_sa(size_t count, size_t bytes);
+
+/**
+ * 		Arena functions
+ */
+
+/**
+ * @brief Bump-allocates a zeroed block from an arena
+ *
+ * Opens a new chunk when the current one has no room left.
+ *
+ * @param arena The arena returned by ARENA_BEGIN
+ * @param size Pointer to size array: size[0]=count, size[1]=element size
+ * @param tracker The allocation tracker, cleaned up if a chunk fails
+ *
+ * @return The block, or NULL if arena or size is NULL or the size overflows
+ */
+void	*arena_allocate(t_arena *arena, size_t *size, t_tracker *tracker);
+
+/**
+ * @brief Releases an arena and every block allocated from it
+ *
+ * Runs in time proportional to the number of chunks. In fencing builds
+ * every block's guards are checked first, which walks each block.
+ *
+ * @param arena The arena returned by ARENA_BEGIN
+ *
+ * @return Always NULL
+ */
+void	*arena_end(t_arena *arena);
+
+/**
+ * 		Inline header functions
+ */
+
+/**
+ * @brief Writes the header of a new block
+ *
+ * @param block Start of the block, where the header goes
+ * @param user_ptr Pointer handed to the user
+ * @param size Size of the user portion
+ */
+void		header_init_sa(void *block, const void *user_ptr, size_t size);
+
+/**
+ * @brief Returns the header of a user pointer if its magic is valid
+ *
+ * Reads BLOCK_PREFIX bytes in front of ptr, so ptr must point into
+ * readable memory; that is the trade-off of INLINE_HEADER mode.
+ *
+ * @param ptr The user pointer
+ *
+ * @return The header, or NULL if ptr was not allocated by this library
+ */
+t_header	*header_sa(const void *ptr);
+
+/**
+ * @brief Returns the slot hint stored in the header of ptr
+ *
+ * @param ptr The user pointer
+ *
+ * @return Index of the slot last holding ptr, or SIZE_MAX if unknown
+ */
+size_t		header_slot_sa(const void *ptr);
+
+/**
+ * @brief Records the slot an entry was just stored in
+ *
+ * Does nothing unless INLINE_HEADER is enabled.
+ *
+ * @param entry The stored entry
+ * @param slot Index of its slot in the current slot array
+ */
+void		header_set_slot_sa(const t_allocation *entry, size_t slot);
+
+/**
+ * @brief Invalidates the magic of a block that is being released
+ *
+ * A later FREE_ONE of the same pointer is then rejected as foreign.
+ *
+ * @param entry The entry of the released block
+ */
+void		header_clear_sa(const t_allocation *entry);
+
+/**
+ * @brief Reallocates memory while maintaining tracking information
+ *
+ * This function changes the size of a previously allocated memory block
+ * while preserving its contents and updating the tracking information.
+ * The block is resized in place when possible (resize_in_place_sa());
+ * otherwise a new block is allocated and size[1] bytes are copied.
+ *
+ * @param size Pointer to size array: size[0]=new size, size[1]=n of memecopy size
+ * @param tracker The allocation tracker
+ * @param ptr The pointer to reallocate
+ *
+ * @return Pointer to the reallocated memory, or NULL on failure
+ */
+void	*realloc_ptr(\
+	size_t *size, t_tracker *tracker, void *ptr, t_action action);
+
+/**
+ * @brief Adds externally allocated memory to the tracking system
+ *
+ * This function allows adding memory that was allocated outside the
+ * ft_safe_allocate system to be tracked and safely freed later.
+ *
+ * @param tracker The allocation tracker
+ * @param original_ptr The original pointer from malloc/calloc
+ * @param user_ptr The user-facing pointer (same as original_ptr if no fencing)
+ * @param size Pointer to the size of the allocated memory
+ *
+ * @return SUCCESS if successfully added, ERROR otherwise
+ */
+int		add_to_tracking(\
+	t_tracker *tracker, void *original_ptr, void *user_ptr, size_t *size);
+
+/**
+ * 		Tracking table functions
+ */
+
+/**
+ * @brief Finds the slot tracking a user pointer
+ *
+ * Probes the current array, then the array still being migrated. Probing
+ * stops at the first empty slot, at an entry nearer its home than ptr
+ * would be, or after the array's max_probe.
+ *
+ * @param table The allocation tracking table
+ * @param ptr The user pointer to look up
+ *
+ * @return The live slot holding ptr, or NULL if it is not tracked
+ */
+t_allocation	*table_find_sa(t_table *table, const void *ptr);
+
+/**
+ * @brief table_find_sa() without the inline header hint
+ *
+ * For a pointer whose block may already be gone, so its header must not
+ * be read.
+ *
+ * @param table The allocation tracking table
+ * @param ptr The user pointer to look up, not NULL
+ *
+ * @return The live slot holding ptr, or NULL if it is not tracked
+ */
+t_allocation	*table_probe_sa(t_table *table, const void *ptr);
+
+/**
+ * @brief Distance of the slot at pos from the home slot of ptr
+ *
+ * @param ptr The user pointer stored (or looked up) at pos
+ * @param pos Slot index
+ * @param capacity Number of slots in the array (power of two)
+ */
+size_t		probe_distance_sa(const void *ptr, size_t pos, size_t capacity);
+
+/**
+ * @brief Stores an entry with Robin Hood placement
+ *
+ * Walking from the home slot, the entry takes the first slot whose holder
+ * is nearer its own home, and that holder moves on in its place. The
+ * array must have at least one empty slot.
+ *
+ * @param slots Slot array to fill
+ * @param capacity Number of slots in the array (power of two)
+ * @param entry The entry to copy into the array
+ *
+ * @return The longest distance from home of any entry placed or moved
+ */
+size_t		table_place_sa(\
+	t_allocation *slots, size_t capacity, const t_allocation *entry);
+
+/**
+ * @brief Empties the slot at pos by a backward shift
+ *
+ * Entries following pos move back one slot until an empty slot or an
+ * entry already in its home slot.
+ *
+ * @param slots Slot array
+ * @param capacity Number of slots in the array (power of two)
+ * @param pos Index of the slot to empty
+ */
+void		table_shift_sa(t_allocation *slots, size_t capacity, size_t pos);
+
+/**
+ * @brief Inserts an entry, growing the table when it passes TABLE_MAX_LOAD
+ *
+ * @param table The allocation tracking table
+ * @param entry The entry to copy into the table
+ *
+ * @return SUCCESS, or ERROR if the table is full and cannot grow
+ */
+int		table_insert_sa(t_table *table, const t_allocation *entry);
+
+/**
+ * @brief Releases a slot returned by table_find_sa()
+ *
+ * The entries after it are shifted back, so probe chains stay intact
+ * without tombstones. Slot pointers into the table are stale afterwards.
+ *
+ * @param table The allocation tracking table
+ * @param slot The live slot to release
+ */
+void	table_remove_sa(t_table *table, t_allocation *slot);
+
+/**
+ * @brief Starts a growth: the current array becomes the migration source
+ *
+ * The new capacity keeps the live entries, those still to migrate and
+ * extra about to be added at most half of TABLE_MAX_LOAD. A running
+ * migration carries on behind the new one.
+ *
+ * @param table The allocation tracking table
+ * @param extra Entries the caller is about to insert
+ *
+ * @return SUCCESS, or ERROR if the new array could not be allocated
+ */
+int		table_grow_sa(t_table *table, size_t extra);
+
+/**
+ * @brief Grows the table now if extra more entries would pass
+ *        TABLE_MAX_LOAD, so a batch never grows it halfway through
+ *
+ * @return SUCCESS, or ERROR if the new array could not be allocated
+ */
+int		table_reserve_sa(t_table *table, size_t extra);
+
+/**
+ * @brief Moves up to steps old slots into the current array
+ *
+ * Drains the newest old array first and frees each once every slot of it
+ * has been migrated.
+ *
+ * @param table The allocation tracking table
+ * @param steps Number of old slots to visit
+ */
+void	table_migrate_sa(t_table *table, size_t steps);
+
+/**
+ * @brief Calls fn on every live slot of both slot arrays
+ *
+ * @param table The allocation tracking table
+ * @param fn Callback receiving the live slot and arg
+ * @param arg Opaque argument forwarded to fn
+ */
+void	table_foreach_sa(\
+	t_table *table, void (*fn)(t_allocation *, void *), void *arg);
+
+/**
+ * @brief Frees both slot arrays and resets the table to its empty state
+ *
+ * @param table The allocation tracking table
+ */
+void	table_release_sa(t_table *table);
+
+/**
+ * 		Block and magazine functions
+ */
+
+/**
+ * @brief Starts tracking an entry, through the thread magazine if enabled
+ *
+ * @param tracker The allocation tracker
+ * @param entry The entry to track
+ *
+ * @return SUCCESS, or ERROR if the tracker ran out of room
+ */
+int			track_sa(t_tracker *tracker, const t_allocation *entry);
+
+/**
+ * @brief Stops tracking a pointer, wherever its entry currently lives
+ *
+ * @param tracker The allocation tracker
+ * @param ptr The user pointer
+ * @param entry Receives a copy of the removed entry
+ *
+ * @return SUCCESS if ptr was tracked, ERROR otherwise
+ */
+int			forget_sa(\
+	t_tracker *tracker, const void *ptr, t_allocation *entry);
+
+/**
+ * @brief Block of total bytes, reusing a cached one if any
+ *
+ * Falls back to the slab allocator for small blocks when SLAB_ALLOCATOR
+ * is enabled, to guard pages for page_guarded_sa() sizes, to a mapping
+ * of its own from MMAP_MIN_BLOCK bytes, and to malloc otherwise. Fresh
+ * slabs and mappings are already zero, only reused and malloc'd blocks
+ * are cleared.
+ *
+ * @param total Size of the whole block, BLOCK_OVERHEAD included
+ * @param zero Whether the block must be zero-filled
+ *
+ * @return The block, or NULL on allocation failure
+ */
+void		*block_alloc_sa(size_t total, bool zero);
+
+/**
+ * @brief Block from the size class fitting total
+ *
+ * Pops the class free list, or carves the next block from the class's
+ * current slab, mapping a new SLAB_SIZE slab when it is exhausted.
+ *
+ * @param total Size of the whole block, at most SLAB_MAX_BLOCK
+ * @param zero Whether a recycled block must be cleared
+ *
+ * @return The block (SLAB_ALIGN aligned), or NULL if mmap failed
+ */
+void		*slab_alloc_sa(size_t total, bool zero);
+
+/**
+ * @brief Runs op (pthread_mutex_lock or _unlock) on every class lock
+ */
+void		slab_locks_sa(int (*op)(pthread_mutex_t *));
+
+/**
+ * @brief Returns a block obtained from block_alloc_sa() to its allocator
+ *
+ * Slab blocks are pushed on their class free list; slabs are never
+ * unmapped. Page-guarded blocks and blocks of MMAP_MIN_BLOCK bytes or
+ * more are unmapped, the others are passed to free().
+ *
+ * @param block Start of the block
+ * @param total Size the block was requested with
+ */
+void		block_free_sa(void *block, size_t total);
+
+/**
+ * @brief Bytes actually mapped for a block of total bytes (whole pages)
+ */
+size_t		mapped_size_sa(size_t total);
+
+/**
+ * @brief Anonymous mapping for one large block, already zeroed
+ *
+ * @param total Size of the whole block, at least MMAP_MIN_BLOCK
+ *
+ * @return The block (page aligned), or NULL if mmap failed
+ */
+void		*mmap_block_sa(size_t total);
+void		munmap_block_sa(void *block, size_t total);
+
+/**
+ * @brief Resizes a block that has a mapping of its own
+ *
+ * Uses mremap() where available, which moves page table entries rather
+ * than bytes; elsewhere the block only stays if its page count does not
+ * change. Pages added at the end read as zero.
+ *
+ * @return The block, possibly moved, or NULL if either size is below
+ *         MMAP_MIN_BLOCK or the mapping could not be resized
+ */
+void		*remap_block_sa(void *block, size_t old_total, size_t new_total);
+
+/**
+ * @brief Whether a block of total bytes lives between guard pages
+ */
+bool		page_guarded_sa(size_t total);
+
+/**
+ * @brief Maps a block of total bytes between two PROT_NONE pages
+ *
+ * The block is placed at the end of its readable pages, PAGE_GUARD_ALIGN
+ * aligned; its last GUARD_TAIL bytes (the software end guard and its
+ * padding) fall in the end guard page. The pages are fresh, so the block reads as zero.
+ *
+ * @param total Size of the whole block, BLOCK_OVERHEAD included
+ *
+ * @return The block, or NULL if the mapping failed
+ */
+void		*guard_map_sa(size_t total);
+
+/**
+ * @brief Unmaps a block from guard_map_sa() and its guard pages
+ *
+ * @param block The block returned by guard_map_sa()
+ * @param total The size it was mapped with
+ */
+void		guard_unmap_sa(void *block, size_t total);
+
+/**
+ * @brief Releases the memory of an entry that left the tracker
+ *
+ * Small blocks go back to the thread magazine when it has room; external
+ * blocks (original_ptr == NULL) are always freed.
+ *
+ * @param entry The removed entry
+ */
+void		release_block_sa(const t_allocation *entry);
+
+/**
+ * @brief Returns the magazine registry, creating its thread key once
+ *
+ * @return Pointer to the process-wide registry
+ */
+t_registry	*registry_sa(void);
+
+/**
+ * @brief Returns the calling thread's magazine, creating it on first use
+ *
+ * A magazine released by an exiting thread is reused before a new one is
+ * allocated.
+ *
+ * @return The magazine, or NULL if it could not be allocated
+ */
+t_magazine	*magazine_sa(void);
+
+/**
+ * @brief Returns the calling thread's magazine slot
+ *
+ * NULL until magazine_sa() hands the thread a magazine, and again once the
+ * thread has released it on exit.
+ *
+ * @return Address of the thread-local magazine pointer
+ */
+t_magazine	**magazine_own_sa(void);
+
+/**
+ * @brief Finds the slot holding a pointer in either half of a magazine
+ *
+ * Safe without the lock, as a hint: the slot may change once it returns.
+ *
+ * @param magazine The magazine to search
+ * @param ptr The user pointer
+ *
+ * @return The slot, or NULL if neither half holds ptr
+ */
+t_lf_slot	*magazine_find_sa(t_magazine *magazine, const void *ptr);
+
+/**
+ * @brief Tells the owning thread whether its magazine may hold a pointer
+ *
+ * Reads only the filter bits, so a pointer that left the magazine long ago
+ * costs no probe of the cold slot arrays. Owner only.
+ *
+ * @param magazine The calling thread's magazine
+ * @param ptr The user pointer
+ *
+ * @return false if neither half holds ptr; true if one might
+ */
+bool		magazine_may_hold_sa(t_magazine *magazine, const void *ptr);
+
+/**
+ * @brief Takes ownership of the slot holding ptr in one magazine
+ *
+ * Sets SLOT_BUSY_BIT on the slot key, as lf_claim_sa() does. The caller
+ * stores the key back (ptr or SLOT_TOMBSTONE) when done. The owning
+ * thread calls it without the lock; any other thread holds it.
+ *
+ * @param magazine The magazine to search
+ * @param ptr The user pointer
+ *
+ * @return The claimed slot, or NULL if the magazine does not hold ptr
+ */
+t_lf_slot	*magazine_claim_sa(t_magazine *magazine, const void *ptr);
+
+/**
+ * @brief Removes a pointer from one magazine
+ *
+ * The owning thread calls it without the lock; any other thread holds it.
+ *
+ * @param magazine The magazine to search
+ * @param ptr The user pointer
+ * @param entry Receives a copy of the removed entry
+ *
+ * @return SUCCESS if the magazine held ptr, ERROR otherwise
+ */
+int			magazine_take_sa(\
+	t_magazine *magazine, const void *ptr, t_allocation *entry);
+
+/**
+ * @brief Records an entry in the young half of the caller's magazine
+ *
+ * The young half must have room (used below MAGAZINE_SIZE / 2).
+ *
+ * @param magazine The calling thread's magazine
+ * @param entry The entry to record
+ */
+void		magazine_place_sa(t_magazine *magazine, const t_allocation *entry);
+
+/**
+ * @brief Merges one half of a magazine's pending entries into the tracker
+ *
+ * Called by the owning thread with the magazine lock held. On failure the
+ * entries the tracker did not take stay in the half, so none of them is
+ * lost. When most of the half was still live, the thread's next
+ * allocations bypass the magazine for a while.
+ *
+ * @param tracker The allocation tracker
+ * @param magazine The magazine to flush
+ * @param half Index of the half to merge (0 or 1)
+ *
+ * @return SUCCESS, or ERROR if the tracker ran out of room
+ */
+int			magazine_flush_sa(\
+	t_tracker *tracker, t_magazine *magazine, int half);
+
+/**
+ * @brief Records an entry in the calling thread's magazine
+ *
+ * When the young half is full, the old half is merged into the tracker
+ * and the halves swap roles.
+ *
+ * @param tracker The allocation tracker
+ * @param entry The entry to record
+ *
+ * @return SUCCESS, or ERROR if a flush ran out of room
+ */
+int			magazine_insert_sa(t_tracker *tracker, const t_allocation *entry);
+
+/**
+ * @brief Removes a pointer from the magazines or the tracker
+ *
+ * Other threads' magazines are probed without a lock; only the one that
+ * holds ptr is locked to take it out.
+ *
+ * @param tracker The allocation tracker
+ * @param ptr The user pointer
+ * @param entry Receives a copy of the removed entry
+ *
+ * @return SUCCESS if ptr was tracked, ERROR otherwise
+ */
+int			magazine_remove_sa(\
+	t_tracker *tracker, const void *ptr, t_allocation *entry);
+
+/**
+ * @brief Moves a pointer's entry from whichever magazine holds it into
+ *        the tracker
+ *
+ * The slot stays claimed until the tracker has the entry, and is given
+ * back untouched if the tracker has no room, so the entry is never
+ * untracked. Lets tracker_park_sa() and tracker_update_sa() reach it.
+ *
+ * @param tracker The allocation tracker
+ * @param ptr The user pointer
+ *
+ * @return SUCCESS if the entry is now in the tracker, ERROR if no
+ *         magazine held ptr or the tracker had no room
+ */
+int			magazine_spill_sa(t_tracker *tracker, const void *ptr);
+
+/**
+ * @brief Locks the registry and every magazine
+ *
+ * No half is merged and no magazine changes hands until the matching
+ * unlock; owners still record and free their own entries meanwhile.
+ */
+void		magazine_lock_all_sa(void);
+
+/**
+ * @brief Releases the locks taken by magazine_lock_all_sa()
+ */
+void		magazine_unlock_all_sa(void);
+
+/**
+ * @brief Calls fn on every pending entry of every magazine
+ *
+ * The caller holds magazine_lock_all_sa(). Each entry is claimed while fn
+ * runs, so its owner cannot free the block under it.
+ *
+ * @param fn Callback receiving the entry and arg
+ * @param arg Opaque argument forwarded to fn
+ */
+void		magazine_foreach_sa(void (*fn)(t_allocation *, void *), void *arg);
+
+/**
+ * @brief Hands every pending entry to fn and removes it from its magazine
+ *
+ * The caller holds magazine_lock_all_sa(). Cached blocks belong to their
+ * thread and are left alone; see magazine_purge_sa().
+ *
+ * @param fn Callback receiving the entry and arg
+ * @param arg Opaque argument forwarded to fn
+ */
+void		magazine_drain_sa(void (*fn)(t_allocation *, void *), void *arg);
+
+/**
+ * @brief Frees every block cached in a magazine
+ *
+ * @param magazine The calling thread's magazine
+ */
+void		magazine_purge_sa(t_magazine *magazine);
+
+/**
+ *  	cleanup functions
+ */
+
+/**
+ * @brief Frees an array of pointers tracked in the allocation system
+ *
+ * This function frees a list of pointers stored in a double pointer array.
+ * It will free 'count' number of pointers from the array.
+ *
+ * @param tracker The allocation tracker
+ * @param double_ptr Array of pointers to free
  * @param count Number of pointers to free from the array
  *
  * @return Always returns NULL to indicate the memory has been freed
  */
-void	*free_list(t_allocation *ptr_array, void **double_ptr, int count);
+void	*free_list(t_tracker *tracker, void **double_ptr, int count);
 
 /**
  * @brief Frees a single pointer tracked in the allocation system
@@ -280,12 +2354,12 @@ void	*free_list(t_allocation *ptr_array, void **double_ptr, int count);
  * This function frees a pointer that was allocated without memory fencing.
  * It searches for the pointer in the tracking array and frees it if found.
  *
- * @param ptr_array The allocation tracking array
+ * @param tracker The allocation tracker
  * @param ptr The pointer to free
  *
  * @return Always returns NULL to indicate the memory has been freed
  */
-void	*free_one(t_allocation *ptr_array, const void *ptr);
+void	*free_one(t_tracker *tracker, const void *ptr);
 
 /**
  * @brief Frees a single pointer with memory fencing enabled
@@ -293,20 +2367,20 @@ void	*free_one(t_allocation *ptr_array, const void *ptr);
  * This function frees a pointer that was allocated with memory fencing.
  * It checks guard bytes for corruption before freeing the memory.
  *
- * @param ptr_array The allocation tracking array
+ * @param tracker The allocation tracker
  * @param ptr The user pointer to free (points after guard bytes)
  *
  * @return Always returns NULL to indicate the memory has been freed
  */
-void	*free_one_memfen(t_allocation *ptr_array, const void *ptr);
+void	*free_one_memfen(t_tracker *tracker, const void *ptr);
 
 /**
  * @brief Performs cleanup operations when an error occurs
  * 
- * @param ptr_array Array of allocated memory pointers to be freed
+ * @param tracker The allocation tracker to be freed
  * @return void* Returns NULL to indicate error condition
  */
-void	*error_cleanup_sa(t_allocation *ptr_array);
+void	*error_cleanup_sa(t_tracker *tracker);
 
 /**
  * 		Memory fencing functions
@@ -338,6 +2412,34 @@ void	*setup_memfen(void *ptr, size_t total_size);
  */
 int		check_memfen(void *user_ptr, size_t user_size);
 
+/**
+ * @brief Canary expected in the guard word at guard
+ *
+ * Mixes the guard's address with a secret drawn from getrandom() on the
+ * first call, so a copied guard or a stray constant does not match.
+ */
+uint64_t	canary_sa(const void *guard);
+
+/**
+ * @brief Address of the end guard of a block: the first GUARD_SIZE-aligned
+ *        word at or after user_ptr + size
+ */
+unsigned char	*end_guard_sa(const void *user_ptr, size_t size);
+
+/**
+ * @brief Whether the front guard of a block holds its canary
+ */
+bool	start_intact_sa(const void *user_ptr);
+
+/**
+ * @brief Whether the end guard of a block, and the padding in front of
+ *        it, hold their canary
+ *
+ * One aligned load, plus a masked one when the size is not a multiple of
+ * GUARD_SIZE.
+ */
+bool	end_intact_sa(const void *user_ptr, size_t size);
+
 /**
  * @brief Utility functions
  */
@@ -347,4 +2449,498 @@ void	*ft_memcpy_sa(void *dst, const void *src, size_t n);
 void	ft_putstr_fd_sa(char *s, int fd);
 void	ft_puthex_fd_sa(unsigned long n, int fd);
 
+/**
+ * @brief Returns the diagnostics ring, initializing it on first use
+ *
+ * The first call also registers the fork handlers and the exit flush.
+ *
+ * @return The process-wide t_diag
+ */
+t_diag	*diag_sa(void);
+
+/**
+ * @brief Queues one diagnostic line without blocking
+ *
+ * Claims the next slot with compare-and-swap, copies the line and
+ * publishes it, then starts the flusher thread if none is running. When
+ * the ring is full the line is dropped and counted. After the exit flush
+ * lines are written immediately instead.
+ *
+ * @param text The line
+ * @param len Its length, at most DIAG_LINE
+ */
+void	diag_push_sa(const char *text, size_t len);
+
+/**
+ * @brief Queue a message, or a message around a pointer printed in hex
+ *
+ * The pieces are formatted into one line on the stack first, so a
+ * message is never interleaved with another thread's.
+ */
+void	diag_msg_sa(const char *msg);
+void	diag_ptr_sa(const char *head, const void *ptr, const char *tail);
+
+/**
+ * @brief Append a string or a number in base 2 to 16 to a line
+ *
+ * Stops at DIAG_LINE bytes.
+ *
+ * @return The new length of the line
+ */
+size_t	diag_cat_sa(char *line, size_t len, const char *s);
+size_t	diag_num_sa(char *line, size_t len, size_t n, size_t base);
+
+/**
+ * @brief Writes every published line with one writev(), oldest first
+ *
+ * diag_drain_sa() expects flush_lock to be held. Once the lines are
+ * written their slots are handed back to producers, and the number of
+ * lines dropped since the last flush, if any, is reported.
+ */
+void	diag_drain_sa(t_diag *diag);
+void	diag_flush_sa(void);
+
+/**
+ * @brief Handles the DIAG_TARGET action
+ *
+ * Pending lines are written to the old target first. A descriptor opened
+ * from a path is closed when the target changes again.
+ *
+ * @param size size[0] is the new descriptor, used when path is NULL
+ * @param path File to append to, created if needed
+ *
+ * @return NULL; an error line is queued if path cannot be opened. With
+ *         neither size nor path the target goes back to DIAG_FD
+ */
+void	*diag_target_sa(size_t *size, const char *path);
+
+/**
+ * @brief fork() and exit handlers registered by diag_sa()
+ *
+ * A fork waits for the running flush and writes the pending lines first,
+ * so the child does not print them again. The child has no flusher
+ * thread; its next message starts one. At exit the ring is written and
+ * later messages go straight to the target.
+ */
+void	diag_fork_prepare_sa(void);
+void	diag_fork_parent_sa(void);
+void	diag_fork_child_sa(void);
+void	diag_exit_sa(void);
+
+/**
+ * @brief Registers the fork() handlers of the allocator, once
+ *
+ * Called by the first use of each lock. Before fork(), every allocator
+ * lock is taken in a fixed order: scrubber, leak report, magazine registry
+ * and magazines, shards (or the lock-free overflow table), slab classes,
+ * heap profile. Both the parent and the child release them afterwards, so
+ * the child never inherits a lock held by a thread it does not have.
+ * Call sites count with atomics and have no lock.
+ */
+void	fork_handlers_sa(void);
+
+/**
+ * @brief Returns the instrumentation counters (INSTRUMENT builds only)
+ *
+ * The first call registers instr_exit_sa() with atexit().
+ */
+t_instr	*instr_sa(void);
+
+/**
+ * @brief Reads the TSC on x86, CLOCK_MONOTONIC in nanoseconds elsewhere
+ */
+uint64_t	instr_clock_sa(void);
+
+/**
+ * @brief Takes a shard lock, counting it and timing the wait if the lock
+ *        was already held
+ */
+void	instr_lock_sa(pthread_mutex_t *lock);
+
+/**
+ * @brief Record one action's latency, a probe length (INSTR_FIND or
+ *        INSTR_PLACE, 0 counts as 1) or the duration of one guard check
+ */
+void	instr_action_sa(t_action action, uint64_t cycles);
+void	instr_probe_sa(int kind, size_t slots);
+void	instr_fence_sa(uint64_t cycles);
+
+/**
+ * @brief Handles the GET_PROFILE action
+ *
+ * @return profile, or NULL if profile is NULL or INSTRUMENT is off
+ */
+void	*get_profile_sa(t_profile *profile);
+
+/**
+ * @brief Writes the profile to the diagnostics target at exit
+ *
+ * instr_report_sa() queues one line per action that ran (calls, mean,
+ * p50 and p99 latency) and one per probe histogram; instr_exit_sa() adds
+ * a line with the lock and guard check counters.
+ */
+void	instr_report_sa(const t_profile *profile);
+void	instr_exit_sa(void);
+
+/**
+ * @brief Returns the site table (ALLOC_SITES builds only)
+ */
+t_sites	*sites_sa(void);
+
+/**
+ * @brief Caller of the calling thread's current ft_safe_allocate() call
+ *
+ * Initial-exec, so reading it never calls __tls_get_addr(), which may
+ * itself allocate.
+ */
+extern _Thread_local void	*g_site_caller_sa
+	__attribute__((tls_model("initial-exec")));
+
+/**
+ * @brief Notes the caller of the current ft_safe_allocate() call
+ *
+ * Blocks tracked by this thread until the next call are tagged with it,
+ * and the stacks HEAP_PROFILE samples start at it.
+ */
+static inline void	site_enter_sa(void *caller)
+{
+	g_site_caller_sa = caller;
+}
+
+/**
+ * @brief Returns the index of caller's site, claiming a slot on first use
+ *
+ * @return The slot index, or 0 when caller is NULL or the table is full
+ */
+size_t	site_intern_sa(void *caller);
+
+/**
+ * @brief Tags a new entry with the caller of the current call
+ *
+ * Every tagged entry must then be counted once with site_account_sa(),
+ * like stats_add_sa(), before it becomes visible in the tracker. The entry
+ * starts out unsampled.
+ */
+void	site_tag_sa(t_allocation *entry);
+
+/**
+ * @brief Returns the site index of an entry, 0 without ALLOC_SITES
+ */
+size_t	site_of_sa(const t_allocation *entry);
+
+/**
+ * @brief Adds an entry to its site's live counters, or removes it
+ *
+ * @param entry	Entry tagged by site_tag_sa()
+ * @param add	true when the entry enters the tracker, false when it leaves
+ */
+void	site_account_sa(const t_allocation *entry, bool add);
+
+/**
+ * @brief Handles the GET_SITES action
+ *
+ * Sites are copied by decreasing live_bytes, so an array shorter than the
+ * number of sites receives the largest ones.
+ *
+ * @param size	size[0] is the number of entries available in out
+ * @param out	Array to fill
+ *
+ * @return Entries filled, or sites in use if size or out is NULL; always 0
+ *         when ALLOC_SITES is off
+ */
+size_t	get_sites_sa(const size_t *size, t_site_stats *out);
+
+/**
+ * @brief Opens a report target: path, created or truncated, else the
+ *        descriptor size[0], else DIAG_FD
+ *
+ * @return The descriptor, or -1 if path cannot be opened
+ */
+int		out_open_sa(const size_t *size, const char *path);
+
+/**
+ * @brief Appends len bytes to out, writing the buffer first when full
+ *
+ * len must not exceed OUT_BUFFER.
+ */
+void	out_line_sa(t_out *out, const char *line, size_t len);
+
+/**
+ * @brief Writes and empties the buffer; stops at the first write error
+ */
+void	out_flush_sa(t_out *out);
+
+/**
+ * @brief Handles the LEAK_REPORT action
+ *
+ * Picks where and how the report is written, and registers
+ * leak_report_sa() with atexit() the first time. A path is opened (and
+ * truncated) right away; without one, size[0] is the descriptor, DIAG_FD
+ * if size is NULL.
+ * Calling it again changes the target and arms the report again.
+ *
+ * @return NULL
+ */
+void	*leak_action_sa(const size_t *size, const char *path);
+
+/**
+ * @brief Writes the leak report once, if armed
+ *
+ * Runs at exit, and in error_cleanup_sa() before every block is freed.
+ * Flushes the diagnostics ring first.
+ */
+void	leak_report_sa(void);
+
+/**
+ * @brief The leak report state; its lock is held while a report runs
+ */
+t_leak	*leak_sa(void);
+
+/**
+ * @brief Groups every tracked block by size and site
+ *
+ * Walks the tracker, and the magazines under magazine_lock_all_sa(). If a
+ * table cannot be allocated, groups->slots is left NULL, but blocks and
+ * bytes still count every block. The caller frees groups->slots.
+ */
+void	leak_collect_sa(t_leak_groups *groups);
+
+/**
+ * @brief Moves the groups to the front of the table and sorts them by
+ *        decreasing size, then decreasing count
+ *
+ * @return Number of groups
+ */
+size_t	leak_sort_sa(t_leak_groups *groups);
+
+/**
+ * @brief Writes the sorted groups in the given format
+ */
+void	leak_write_sa(\
+	t_out *out, const t_leak_groups *groups, size_t n, int format);
+
+/**
+ * @brief Returns the heap profile (HEAP_PROFILE builds only)
+ *
+ * The first call allocates the buckets and loads what backtrace() needs,
+ * so sampling never allocates through malloc() on the way.
+ *
+ * @return The profile, whose buckets are NULL if calloc() failed
+ */
+t_heap	*heap_sa(void);
+
+/**
+ * @brief Handles the SAMPLE_RATE action
+ *
+ * The new rate applies to each thread from its next sample. A profile
+ * mixing samples taken at different rates is scaled by the last one.
+ *
+ * @return NULL
+ */
+void	*sample_rate_sa(const size_t *size);
+
+/**
+ * @brief Draws the bytes until the next sample, exponentially distributed
+ *        around rate
+ *
+ * @return At least 1
+ */
+int64_t	sample_draw_sa(t_sampler *sampler, size_t rate);
+
+/**
+ * @brief Records entry and draws the sampler's next countdown
+ *
+ * The first call of each thread only seeds its sampler. Nothing is
+ * recorded while the rate is 0; the countdown is then HEAP_SAMPLE_RATE.
+ * The library's own frames are dropped up to the caller the entry point
+ * passed to site_enter_sa(), looking at most HEAP_SKIP_MAX frames deep.
+ */
+void	sample_record_sa(t_sampler *sampler, t_allocation *entry);
+
+/**
+ * @brief The calling thread's heap sampler, initial-exec like
+ *        g_site_caller_sa
+ */
+extern _Thread_local t_sampler	g_sampler_sa
+	__attribute__((tls_model("initial-exec")));
+
+/**
+ * @brief Counts entry down the calling thread's sampler, and records it in
+ *        the heap profile if it crossed the end of the countdown
+ *
+ * Inline, so an allocation that does not end the countdown makes no call.
+ * Must run before the entry becomes visible in the tracker.
+ */
+static inline void	sample_take_sa(t_allocation *entry)
+{
+	g_sampler_sa.countdown -= (int64_t)entry->size;
+	if (g_sampler_sa.countdown < 0)
+		sample_record_sa(&g_sampler_sa, entry);
+}
+
+/**
+ * @brief Returns the bucket of a stack, claiming one on first use
+ *
+ * Called with the heap lock held.
+ *
+ * @return The bucket index, 0 when the table is full
+ */
+size_t	sample_bucket_sa(\
+	t_heap_bucket *buckets, void *const *stack, size_t depth);
+
+/**
+ * @brief Removes a sampled entry from the in-use counters; a no-op for an
+ *        entry that was not sampled
+ */
+void	sample_release_sa(const t_allocation *entry);
+
+/**
+ * @brief Marks an entry as sampled in a bucket, or not sampled with 0
+ */
+void	sample_mark_sa(t_allocation *entry, size_t mark);
+
+/**
+ * @brief Returns what sample_mark_sa() stored, 0 without HEAP_PROFILE
+ */
+size_t	sample_of_sa(const t_allocation *entry);
+
+/**
+ * @brief Handles the HEAP_DUMP action
+ *
+ * Writes the sampled allocations in the legacy heap format of pprof and
+ * gperftools (heap_v2): in-use and total counts per stack, followed by the
+ * memory map of the process. The counts are those of the samples; pprof
+ * scales them by the rate written in the header.
+ *
+ * @return NULL
+ */
+void	*heap_dump_sa(const size_t *size, const char *path);
+
+/**
+ * @brief Starts the fence scrubber the first time it is called
+ */
+void	scrub_start_sa(void);
+
+/**
+ * @brief The scrubber state
+ */
+t_scrub	*scrub_sa(void);
+
+/**
+ * @brief Coarse monotonic time in milliseconds, used for the stamps
+ */
+uint64_t	scrub_now_sa(void);
+
+/**
+ * @brief Body of the scrubber thread; arg is the t_scrub
+ */
+void	*scrub_loop_sa(void *arg);
+
+/**
+ * @brief Checks the guards of one entry, reports them if corrupted and
+ *        stamps the entry
+ *
+ * Called with the lock that protects the entry held.
+ *
+ * @param arg	Points to the uint64_t time of the check
+ */
+void	scrub_entry_sa(t_allocation *entry, void *arg);
+
+/**
+ * @brief Calls fn on the entries of the next SCRUB_STEP slots after
+ *        cursor, under the lock protecting them, and advances cursor
+ *
+ * Entries moved by a rehash or a deletion while the walk is between two
+ * steps can be skipped or seen twice in that pass.
+ *
+ * @return true when the step finished a pass over the whole tracker
+ */
+bool	tracker_step_sa(\
+	t_tracker *tracker, size_t *cursor,
+	void (*fn)(t_allocation *, void *), void *arg);
+
+/**
+ * @brief Stores when the entry's guards were last found intact
+ */
+void	scrub_stamp_sa(t_allocation *entry, uint64_t when);
+
+/**
+ * @brief Returns what scrub_stamp_sa() stored, 0 without FENCE_SCRUB
+ */
+uint64_t	scrub_stamp_of_sa(const t_allocation *entry);
+
+/**
+ * @brief Marks the calling thread as inside the preload allocator
+ *
+ * Always pair with preload_leave_sa().
+ *
+ * @return true for the outermost call, false for a call made from within
+ *         the tracker, which must go to glibc
+ */
+bool	preload_enter_sa(void);
+
+/**
+ * @brief Undoes one preload_enter_sa()
+ */
+void	preload_leave_sa(void);
+
+/**
+ * @brief Allocates and tracks a block for the interposed functions
+ *
+ * @param align Alignment, as in allocate_ptr()
+ *
+ * @return The user pointer, or NULL with errno set to ENOMEM
+ */
+void	*preload_alloc_sa(size_t bytes, size_t align, bool zero);
+
+/**
+ * @brief Untracks, checks and releases a block for the interposed free()
+ *
+ * @return SUCCESS, or ERROR if ptr is not tracked
+ */
+int		preload_release_sa(void *ptr);
+
+/**
+ * @brief The interposed realloc() for a non-NULL ptr and non-zero size
+ *
+ * Resizes in place when it can, otherwise copies. Pointers the tracker
+ * does not know go to glibc.
+ *
+ * @return The new user pointer, or NULL with ptr still tracked and untouched
+ */
+void	*preload_realloc_sa(void *ptr, size_t size);
+
+/**
+ * @brief Returns the memset/memcpy implementations used for this CPU
+ *
+ * The choice is made once, with __builtin_cpu_supports(), by the first
+ * caller: AVX2 first, then SSE2, then the word-wide scalar versions.
+ * Every version produces the same bytes as a plain byte loop.
+ *
+ * @return The selected t_memops, never NULL
+ */
+const t_memops	*memops_sa(void);
+
+/**
+ * @brief Scalar memset/memcpy writing one machine word per iteration
+ *
+ * The destination is first brought to word alignment byte by byte, the
+ * tail is finished the same way. Source and destination must not overlap.
+ */
+void	*word_memset_sa(void *b, int c, size_t len);
+void	*word_memcpy_sa(void *dst, const void *src, size_t n);
+
+/**
+ * @brief SSE2 (16 bytes) and AVX2 (32 bytes) memset/memcpy
+ *
+ * Only built when SIMD_MEMOPS is enabled, and only called once
+ * memops_sa() has checked the CPU supports them. Lengths of at least one
+ * vector end with an unaligned store overlapping the previous one, the
+ * rest goes to the word-wide versions.
+ */
+void	*sse2_memset_sa(void *b, int c, size_t len);
+void	*sse2_memcpy_sa(void *dst, const void *src, size_t n);
+void	*avx2_memset_sa(void *b, int c, size_t len);
+void	*avx2_memcpy_sa(void *dst, const void *src, size_t n);
+
 #endif /* FT_SAFE_ALLOCATE_H */